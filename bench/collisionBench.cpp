@@ -0,0 +1,285 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../headers/Circle.h"
+#include "../headers/collisionKernel.h"
+#include "../headers/getDistance.h"
+#include "../headers/LSpatialHash.h"
+
+//A box the way SDL_Rect lays it out, the kernels need no SDL
+struct Box {
+    int x, y, w, h;
+};
+
+//The Circle-Box test the game used before the kernels, kept here as the baseline
+static bool referenceCollision(const Circle& a, const Box& b) {
+    int cX, cY;
+    if (a.x < b.x) {
+        cX = b.x;
+    }
+    else if (a.x > b.x + b.w) {
+        cX = b.x + b.w;
+    }
+    else {
+        cX = a.x;
+    }
+    if (a.y < b.y) {
+        cY = b.y;
+    }
+    else if (a.y > b.y + b.h) {
+        cY = b.y + b.h;
+    }
+    else {
+        cY = a.y;
+    }
+    return distanceSquared(a.x, a.y, cX, cY) < a.r*a.r;
+}
+
+//Keeps results alive so passes are not optimized away
+struct Sink {
+    uint64_t value = 0;
+};
+
+//Always zero, read through volatile so the compiler cannot hoist identical passes out of the timing loop
+static volatile int gOffset = 0;
+
+//Times repeated passes over every query, returns nanoseconds per test
+template<typename F>
+static double measure(const int iterations, const int tests, Sink& sink, const F& pass) {
+    //One pass untimed to warm caches
+    sink.value += pass(gOffset);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink.value += pass(gOffset);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / (static_cast<double>(iterations) * tests);
+}
+
+//Prints one row of timings
+static void report(const char* name, const double reference, const double scalar, const double kernel) {
+    printf("%-24s reference %6.2f ns  scalar %6.2f ns  kernel %6.2f ns  speedup %5.2fx\n", name, reference, scalar, kernel, reference / kernel);
+}
+
+//Times the batched collision kernels against one test per pair, needs no SDL
+int main(int argc, char* args[]) {
+    int iterations = 2000;
+    int queries = 1024;
+    int movers = 20000;
+
+    //Read options
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(args[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, atoi(args[++i]));
+        }
+        else if (strcmp(args[i], "--queries") == 0 && i + 1 < argc) {
+            queries = std::max(1, atoi(args[++i]));
+        }
+        else if (strcmp(args[i], "--circles") == 0 && i + 1 < argc) {
+            movers = std::max(1, atoi(args[++i]));
+        }
+        else {
+            printf("Usage: %s [--iterations N] [--queries N] [--circles N]\n", args[0]);
+            return 1;
+        }
+    }
+
+#if defined(__AVX__)
+    printf("Kernel width: AVX, 8 lanes\n");
+#elif defined(__SSE2__)
+    printf("Kernel width: SSE, 4 lanes\n");
+#else
+    printf("Kernel width: scalar\n");
+#endif
+
+    //Seeded so every run tests the same shapes
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> position(0, 640);
+    std::uniform_int_distribution<int> size(10, 80);
+    std::uniform_int_distribution<int> radius(5, 40);
+
+    Sink sink;
+    bool matches = true;
+
+    //One circle against a batch of boxes, three by three tiles is what touchesWall sees, a full batch is the best case
+    for (const int boxCount : {9, COLLISION_BATCH_SIZE}) {
+        std::vector<Box> boxes(boxCount);
+        LBoxBatch batch;
+        batch.count = 0;
+        for (Box& box : boxes) {
+            box = {position(random), position(random), size(random), size(random)};
+            addBox(batch, box.x, box.y, box.w, box.h);
+        }
+        std::vector<Circle> circles(queries);
+        for (Circle& circle : circles) {
+            circle = {position(random), position(random), radius(random)};
+        }
+
+        const auto referencePass = [&](const int offset) {
+            uint64_t hits = 0;
+            for (const Circle& circle : circles) {
+                uint64_t mask = 0;
+                for (int i = 0; i < boxCount; ++i) {
+                    if (referenceCollision({circle.x + offset, circle.y, circle.r}, boxes[i])) {
+                        mask |= uint64_t{1} << i;
+                    }
+                }
+                hits = hits * 31 + mask;
+            }
+            return hits;
+        };
+        const auto scalarPass = [&](const int offset) {
+            uint64_t hits = 0;
+            for (const Circle& circle : circles) {
+                hits = hits * 31 + circleVsBoxesScalar(static_cast<float>(circle.x + offset), static_cast<float>(circle.y), static_cast<float>(circle.r), batch);
+            }
+            return hits;
+        };
+        const auto kernelPass = [&](const int offset) {
+            uint64_t hits = 0;
+            for (const Circle& circle : circles) {
+                hits = hits * 31 + circleVsBoxes(static_cast<float>(circle.x + offset), static_cast<float>(circle.y), static_cast<float>(circle.r), batch);
+            }
+            return hits;
+        };
+
+        //Every path must agree bit for bit before its timing means anything
+        const uint64_t expected = referencePass(0);
+        if (scalarPass(0) != expected || kernelPass(0) != expected) {
+            printf("Hit masks differ for %d boxes!\n", boxCount);
+            matches = false;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "circle vs %d boxes", boxCount);
+        const int tests = queries * boxCount;
+        const double reference = measure(iterations, tests, sink, referencePass);
+        const double scalar = measure(iterations, tests, sink, scalarPass);
+        const double kernel = measure(iterations, tests, sink, kernelPass);
+        report(name, reference, scalar, kernel);
+    }
+
+    //Batches of candidate pairs the spatial hash hands the narrowphase, centres close enough to touch about half the time
+    {
+        std::uniform_int_distribution<int> offset(-60, 60);
+        std::vector<Circle> circles(2 * queries);
+        for (int i = 0; i < queries; ++i) {
+            circles[2 * i] = {position(random), position(random), radius(random)};
+            circles[2 * i + 1] = {circles[2 * i].x + offset(random), circles[2 * i].y + offset(random), radius(random)};
+        }
+        const int batchCount = (queries + COLLISION_BATCH_SIZE - 1) / COLLISION_BATCH_SIZE;
+
+        //Every pass shifts the second circle of each pair, shifting both would cancel out of the offsets the batches hold
+        const auto referencePass = [&](const int offset) {
+            uint64_t hits = 0;
+            for (int batch = 0; batch < batchCount; ++batch) {
+                uint64_t mask = 0;
+                for (int i = batch * COLLISION_BATCH_SIZE; i < std::min(queries, (batch + 1) * COLLISION_BATCH_SIZE); ++i) {
+                    const Circle& a = circles[2 * i];
+                    const Circle& b = circles[2 * i + 1];
+                    const int reach = a.r + b.r;
+                    if (distanceSquared(a.x, a.y, b.x + offset, b.y) < reach * reach) {
+                        mask |= uint64_t{1} << (i - batch * COLLISION_BATCH_SIZE);
+                    }
+                }
+                hits = hits * 31 + mask;
+            }
+            return hits;
+        };
+
+        //Batches are filled inside the timing, as resolveContacts fills them every tick
+        const auto batchedPass = [&](const int offset, const auto& test) {
+            uint64_t hits = 0;
+            LCirclePairBatch batch;
+            for (int first = 0; first < queries; first += COLLISION_BATCH_SIZE) {
+                batch.count = 0;
+                for (int i = first; i < std::min(queries, first + COLLISION_BATCH_SIZE); ++i) {
+                    const Circle& a = circles[2 * i];
+                    const Circle& b = circles[2 * i + 1];
+                    addCirclePair(batch, a.x, a.y, a.r, b.x + offset, b.y, b.r);
+                }
+                hits = hits * 31 + test(batch);
+            }
+            return hits;
+        };
+        const auto scalarPass = [&](const int offset) {
+            return batchedPass(offset, [](const LCirclePairBatch& batch) { return circlePairsTouchScalar(batch); });
+        };
+        const auto kernelPass = [&](const int offset) {
+            return batchedPass(offset, [](const LCirclePairBatch& batch) { return circlePairsTouch(batch); });
+        };
+
+        const uint64_t expected = referencePass(0);
+        if (scalarPass(0) != expected || kernelPass(0) != expected) {
+            printf("Hit masks differ for circle pairs!\n");
+            matches = false;
+        }
+
+        const double reference = measure(iterations, queries, sink, referencePass);
+        const double scalar = measure(iterations, queries, sink, scalarPass);
+        const double kernel = measure(iterations, queries, sink, kernelPass);
+        report("circle pairs", reference, scalar, kernel);
+    }
+
+    //Agent sized circles over a level of 64 by 48 tiles, every pair touching found through the spatial hash
+    {
+        std::uniform_real_distribution<float> levelX(0.f, 5120.f), levelY(0.f, 3840.f);
+        std::vector<float> x(movers), y(movers);
+        std::vector<int> r(movers, 10);
+        for (int i = 0; i < movers; ++i) {
+            x[i] = levelX(random);
+            y[i] = levelY(random);
+        }
+
+        //The narrowphase checkCollision runs, on whole pixels
+        const auto touching = [&](const int a, const int b, const int offset) {
+            const int reach = r[a] + r[b];
+            return distanceSquared(static_cast<int>(x[a]) + offset, static_cast<int>(y[a]), static_cast<int>(x[b]) + offset, static_cast<int>(y[b])) < reach * reach;
+        };
+
+        LSpatialHash hash;
+        std::vector<LCollisionPair> pairs;
+        int candidates = 0;
+        const auto hashPass = [&](const int offset) {
+            hash.build(x.data(), y.data(), r.data(), movers);
+            hash.findPairs(pairs);
+            candidates = static_cast<int>(pairs.size());
+            uint64_t hits = 0;
+            for (const LCollisionPair& pair : pairs) {
+                if (touching(pair.a, pair.b, offset)) {
+                    hits += static_cast<uint64_t>(pair.a) * movers + pair.b;
+                }
+            }
+            return hits;
+        };
+
+        //Every pair tested once, slow enough that it only runs to check the hash
+        uint64_t expected = 0;
+        for (int a = 0; a < movers; ++a) {
+            for (int b = a + 1; b < movers; ++b) {
+                if (touching(a, b, 0)) {
+                    expected += static_cast<uint64_t>(a) * movers + b;
+                }
+            }
+        }
+        if (hashPass(0) != expected) {
+            printf("Spatial hash missed pairs among %d circles!\n", movers);
+            matches = false;
+        }
+
+        const double perPass = measure(std::max(1, iterations / 20), 1, sink, hashPass);
+        printf("%d circles spatial hash  %.3f ms per tick, %d candidate pairs\n", movers, perPass / 1000000.0, candidates);
+    }
+
+    //Printed so the compiler has to keep every pass
+    printf("Checksum: %016llx\n", static_cast<unsigned long long>(sink.value));
+    return matches ? 0 : 1;
+}
@@ -11,22 +11,73 @@
 //Get LTexture class
 #include "LTexture.h"
 
+//Get LTextureAtlas class
+#include "LTextureAtlas.h"
+
 //Get LTimer class
 #include "LTimer.h"
 
+//Get LHighResTimer class
+#include "LHighResTimer.h"
+
+//Get LFramePacer class
+#include "LFramePacer.h"
+
+//Get LProfiler class
+#include "LProfiler.h"
+
+//Get LSpriteBatch class
+#include "LSpriteBatch.h"
+
 //Get LDot class
 #include "LDot.h"
 
+//Get LJobSystem class
+#include "LJobSystem.h"
+
+//Get LWorld class
+#include "LWorld.h"
+
+//Get LSpatialHash class
+#include "LSpatialHash.h"
+
 //Get Circle struct
 #include "Circle.h"
 
+//Get LFixed class
+#include "LFixed.h"
+
+//Get LStateHash class
+#include "LStateHash.h"
+
 //Get DeltaTime class
 #include "DeltaTime.h"
 
 //Get LCamera class
 #include "LCamera.h"
 
-//Get LTile class
-#include "LTile.h"
+//Get LTileMap class
+#include "LTileMap.h"
+
+//Get LTileLayer class
+#include "LTileLayer.h"
+
+//Get LChunkStreamer class
+#include "LChunkStreamer.h"
+
+//Get LGlyphAtlas class
+#include "LGlyphAtlas.h"
+
+//Get LAssetLoader class
+#include "LAssetLoader.h"
+
+//Get LAssetCache class
+#include "LAssetCache.h"
+
+//Get LHotReloader class
+#include "LHotReloader.h"
+
+//Get LInputRecorder class
+#include "LInputRecorder.h"
 
 #endif //ALLHEADERS_H
@@ -4,7 +4,7 @@
 
 #ifndef DELTATIME_H
 #define DELTATIME_H
-#include "LTimer.h"
+#include "LHighResTimer.h"
 
 class DeltaTime {
 public:
@@ -20,14 +20,38 @@ public:
     //Get delta time
     float getDeltaTime();
 
+    //Switch to fixed steps of 1 / tickRate seconds, running at most maxSteps per update
+    void setFixedTimestep(int tickRate, int maxSteps);
+
+    //Switch back to one variable step per update
+    void setVariableTimestep();
+
+    //Checks the update mode
+    bool isFixedTimestep() const;
+
+    //Consumes the next simulation step, false once the elapsed time is used up
+    bool tick();
+
+    //Fraction of a step left over after ticking, for interpolating rendering
+    float getAlpha() const;
+
     //Renamed deallocation of memory
     void free();
 
 private:
-    LTimer mTimer;
+    LHighResTimer mTimer;
     float mDeltaTime;
-    float mLastTime;
-    float mCurrentTime;
+    Uint64 mLastTime;
+    Uint64 mCurrentTime;
+
+    //Fixed timestep state
+    bool mFixed;
+    float mFixedStep;
+    int mMaxSteps;
+    float mAccumulator;
+
+    //Variable step not yet consumed
+    bool mPendingStep;
 };
 
 /*------------------*
@@ -40,26 +64,91 @@ inline DeltaTime::DeltaTime() {
 
     mLastTime = 0;
     mCurrentTime = 0;
+
+    mFixed = false;
+    mFixedStep = 0;
+    mMaxSteps = 1;
+    mAccumulator = 0;
+    mPendingStep = false;
 }
 
 inline DeltaTime::DeltaTime (const float milliseconds) {
     mDeltaTime = milliseconds;
     mTimer.start();
 
-    mLastTime = milliseconds;
+    mLastTime = static_cast<Uint64>(milliseconds * NANOSECONDS_PER_MILLISECOND);
     mCurrentTime = 0;
+
+    mFixed = false;
+    mFixedStep = 0;
+    mMaxSteps = 1;
+    mAccumulator = 0;
+    mPendingStep = false;
 }
 
 inline void DeltaTime::update() {
     mCurrentTime = mTimer.getTicks();
-    mDeltaTime = (mCurrentTime - mLastTime) / 1000.f;
+    const float elapsed = static_cast<float>(static_cast<double>(static_cast<Sint64>(mCurrentTime - mLastTime)) / NANOSECONDS_PER_SECOND);
     mLastTime = mCurrentTime;
+
+    if (mFixed) {
+        //Bank the elapsed time, dropping what cannot be caught up
+        mAccumulator += elapsed;
+        if (mAccumulator > mFixedStep * mMaxSteps) {
+            mAccumulator = mFixedStep * mMaxSteps;
+        }
+    }
+    else {
+        mDeltaTime = elapsed;
+        mPendingStep = true;
+    }
 }
 
 inline float DeltaTime::getDeltaTime() {
     return mDeltaTime;
 }
 
+inline void DeltaTime::setFixedTimestep(const int tickRate, const int maxSteps) {
+    mFixed = true;
+    mFixedStep = 1.f / tickRate;
+    mMaxSteps = maxSteps;
+    mDeltaTime = mFixedStep;
+
+    //Start banking time from now
+    mAccumulator = 0;
+    mLastTime = mTimer.getTicks();
+}
+
+inline void DeltaTime::setVariableTimestep() {
+    mFixed = false;
+    mAccumulator = 0;
+    mPendingStep = false;
+}
+
+inline bool DeltaTime::isFixedTimestep() const {
+    return mFixed;
+}
+
+inline bool DeltaTime::tick() {
+    if (mFixed) {
+        //Run a step if a whole one has been banked
+        if (mAccumulator >= mFixedStep) {
+            mAccumulator -= mFixedStep;
+            return true;
+        }
+        return false;
+    }
+
+    //One step per update
+    const bool step = mPendingStep;
+    mPendingStep = false;
+    return step;
+}
+
+inline float DeltaTime::getAlpha() const {
+    return mFixed ? mAccumulator / mFixedStep : 1.f;
+}
+
 /*-------------------------*
  Global delta time variable
  --------------------------*/
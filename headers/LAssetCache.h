@@ -0,0 +1,319 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LASSETCACHE_H
+#define LASSETCACHE_H
+#include <SDL.h>
+#include <SDL_image.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "LTexture.h"
+#include "SDLDeleter.h"
+
+//Default memory budgets, unused assets are evicted past these
+inline constexpr size_t ASSET_GPU_BUDGET = 256 * 1024 * 1024;
+inline constexpr size_t ASSET_CPU_BUDGET = 64 * 1024 * 1024;
+
+//Shared handles, an asset stays loaded while any handle to it exists
+using LTextureHandle = std::shared_ptr<LTexture>;
+using LSurfaceHandle = std::shared_ptr<SDL_Surface>;
+
+//Loads every path once and hands out shared handles to the result
+class LAssetCache {
+public:
+    //Initializes variables
+    LAssetCache();
+
+    //Sets how much decoded image and texture memory may stay cached
+    void setBudget(size_t gpuBytes, size_t cpuBytes);
+
+    //Gets a decoded image, safe from any thread
+    LSurfaceHandle getSurface(const std::string& path);
+
+    //Gets a texture, render thread only
+    LTextureHandle getTexture(SDL_Renderer* mRenderer, const std::string& path);
+
+    //Drops a path so the next request loads it again, live handles keep the old copy
+    void invalidate(const std::string& path);
+
+    //Decodes a path again and caches the new image, safe from any thread
+    LSurfaceHandle reloadSurface(const std::string& path);
+
+    //Uploads the cached image into an already cached texture, every handle sees the change
+    bool reloadTexture(SDL_Renderer* mRenderer, const std::string& path);
+
+    //Drops unused assets, least recently used first, until within budget
+    void evict();
+
+    //Drops every asset
+    void clear();
+
+    //Gets memory and lookup statistics
+    size_t getGPUBytes();
+    size_t getCPUBytes();
+    int getHits();
+    int getMisses();
+
+    //Prints every cached asset and its memory
+    void printUsage();
+
+private:
+    //A cached asset and its bookkeeping
+    struct Entry {
+        LSurfaceHandle surface;
+        LTextureHandle texture;
+        size_t bytes;
+        Uint64 lastUse;
+    };
+
+    //Evicts from one kind of entry, caller holds the lock
+    static void evict(std::unordered_map<std::string, Entry>& entries, size_t& used, size_t budget);
+
+    //Cached decoded images and textures
+    std::unordered_map<std::string, Entry> mSurfaces;
+    std::unordered_map<std::string, Entry> mTextures;
+
+    //Bytes cached and allowed
+    size_t mCPUBytes;
+    size_t mGPUBytes;
+    size_t mCPUBudget;
+    size_t mGPUBudget;
+
+    //Use counter for recency and lookup statistics
+    Uint64 mUseCount;
+    int mHits;
+    int mMisses;
+
+    //Guards everything, decoding happens outside of it
+    std::mutex mMutex;
+};
+
+/*-------------------*
+LAssetCache functions
+---------------------*/
+
+//Initializes variables
+inline LAssetCache::LAssetCache() {
+    mCPUBytes = 0;
+    mGPUBytes = 0;
+    mCPUBudget = ASSET_CPU_BUDGET;
+    mGPUBudget = ASSET_GPU_BUDGET;
+    mUseCount = 0;
+    mHits = 0;
+    mMisses = 0;
+}
+
+//Sets how much memory may stay cached
+inline void LAssetCache::setBudget(const size_t gpuBytes, const size_t cpuBytes) {
+    {
+        std::lock_guard lock(mMutex);
+        mGPUBudget = gpuBytes;
+        mCPUBudget = cpuBytes;
+    }
+    evict();
+}
+
+//Gets a decoded image
+inline LSurfaceHandle LAssetCache::getSurface(const std::string& path) {
+    //Already decoded
+    {
+        std::lock_guard lock(mMutex);
+        if (const auto found = mSurfaces.find(path); found != mSurfaces.end()) {
+            found->second.lastUse = ++mUseCount;
+            ++mHits;
+            return found->second.surface;
+        }
+        ++mMisses;
+    }
+
+    //Decode without holding the lock so other threads keep loading
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if (loadedSurface == nullptr) {
+        printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+        return nullptr;
+    }
+    LSurfaceHandle surface(loadedSurface, SDLDeleter());
+
+    //Another thread may have decoded it meanwhile, keep the first
+    std::lock_guard lock(mMutex);
+    const auto [entry, inserted] = mSurfaces.try_emplace(path, Entry{surface, nullptr, static_cast<size_t>(surface->pitch) * surface->h, 0});
+    entry->second.lastUse = ++mUseCount;
+    if (inserted) {
+        mCPUBytes += entry->second.bytes;
+        evict(mSurfaces, mCPUBytes, mCPUBudget);
+    }
+    return entry->second.surface;
+}
+
+//Gets a texture
+inline LTextureHandle LAssetCache::getTexture(SDL_Renderer* mRenderer, const std::string& path) {
+    //Already uploaded
+    {
+        std::lock_guard lock(mMutex);
+        if (const auto found = mTextures.find(path); found != mTextures.end()) {
+            found->second.lastUse = ++mUseCount;
+            ++mHits;
+            return found->second.texture;
+        }
+        ++mMisses;
+    }
+
+    //Upload from the cached image
+    const LSurfaceHandle surface = getSurface(path);
+    if (surface == nullptr) {
+        return nullptr;
+    }
+    LTextureHandle texture = std::make_shared<LTexture>();
+    if (!texture->loadFromSurface(mRenderer, surface.get())) {
+        printf("Unable to create texture from %s!\n", path.c_str());
+        return nullptr;
+    }
+
+    //Another thread may have uploaded it meanwhile, keep the first, textures are counted as four bytes a pixel
+    std::lock_guard lock(mMutex);
+    const size_t bytes = static_cast<size_t>(texture->getWidth()) * texture->getHeight() * 4;
+    const auto [entry, inserted] = mTextures.try_emplace(path, Entry{nullptr, texture, bytes, 0});
+    entry->second.lastUse = ++mUseCount;
+    if (inserted) {
+        mGPUBytes += bytes;
+        evict(mTextures, mGPUBytes, mGPUBudget);
+    }
+    return entry->second.texture;
+}
+
+//Drops a path so the next request loads it again
+inline void LAssetCache::invalidate(const std::string& path) {
+    std::lock_guard lock(mMutex);
+    if (const auto found = mSurfaces.find(path); found != mSurfaces.end()) {
+        mCPUBytes -= found->second.bytes;
+        mSurfaces.erase(found);
+    }
+    if (const auto found = mTextures.find(path); found != mTextures.end()) {
+        mGPUBytes -= found->second.bytes;
+        mTextures.erase(found);
+    }
+}
+
+//Decodes a path again
+inline LSurfaceHandle LAssetCache::reloadSurface(const std::string& path) {
+    {
+        std::lock_guard lock(mMutex);
+        if (const auto found = mSurfaces.find(path); found != mSurfaces.end()) {
+            mCPUBytes -= found->second.bytes;
+            mSurfaces.erase(found);
+        }
+    }
+    return getSurface(path);
+}
+
+//Uploads the cached image into an already cached texture
+inline bool LAssetCache::reloadTexture(SDL_Renderer* mRenderer, const std::string& path) {
+    LTextureHandle texture;
+    {
+        std::lock_guard lock(mMutex);
+        if (const auto found = mTextures.find(path); found != mTextures.end()) {
+            texture = found->second.texture;
+        }
+    }
+    if (texture == nullptr) {
+        return false;
+    }
+
+    //Replace the texture behind the shared object
+    const LSurfaceHandle surface = getSurface(path);
+    if (surface == nullptr || !texture->loadFromSurface(mRenderer, surface.get())) {
+        printf("Unable to reload texture %s!\n", path.c_str());
+        return false;
+    }
+
+    //Its size may have changed
+    std::lock_guard lock(mMutex);
+    if (const auto found = mTextures.find(path); found != mTextures.end()) {
+        mGPUBytes -= found->second.bytes;
+        found->second.bytes = static_cast<size_t>(texture->getWidth()) * texture->getHeight() * 4;
+        mGPUBytes += found->second.bytes;
+    }
+    return true;
+}
+
+//Drops unused assets until within budget
+inline void LAssetCache::evict() {
+    std::lock_guard lock(mMutex);
+    evict(mSurfaces, mCPUBytes, mCPUBudget);
+    evict(mTextures, mGPUBytes, mGPUBudget);
+}
+
+//Drops every asset
+inline void LAssetCache::clear() {
+    std::lock_guard lock(mMutex);
+    mSurfaces.clear();
+    mTextures.clear();
+    mCPUBytes = 0;
+    mGPUBytes = 0;
+}
+
+//Gets memory and lookup statistics
+inline size_t LAssetCache::getGPUBytes() {
+    std::lock_guard lock(mMutex);
+    return mGPUBytes;
+}
+
+inline size_t LAssetCache::getCPUBytes() {
+    std::lock_guard lock(mMutex);
+    return mCPUBytes;
+}
+
+inline int LAssetCache::getHits() {
+    std::lock_guard lock(mMutex);
+    return mHits;
+}
+
+inline int LAssetCache::getMisses() {
+    std::lock_guard lock(mMutex);
+    return mMisses;
+}
+
+//Prints every cached asset and its memory
+inline void LAssetCache::printUsage() {
+    std::lock_guard lock(mMutex);
+    for (const auto& [path, entry] : mSurfaces) {
+        printf("Cached image   %-32s %8zu KB, %ld handles\n", path.c_str(), entry.bytes / 1024, entry.surface.use_count() - 1);
+    }
+    for (const auto& [path, entry] : mTextures) {
+        printf("Cached texture %-32s %8zu KB, %ld handles\n", path.c_str(), entry.bytes / 1024, entry.texture.use_count() - 1);
+    }
+    printf("Asset cache: %zu / %zu KB images, %zu / %zu KB textures, %d hits, %d misses\n", mCPUBytes / 1024, mCPUBudget / 1024, mGPUBytes / 1024, mGPUBudget / 1024, mHits, mMisses);
+}
+
+//Evicts from one kind of entry
+inline void LAssetCache::evict(std::unordered_map<std::string, Entry>& entries, size_t& used, const size_t budget) {
+    while (used > budget) {
+        //Least recently used asset nobody else holds
+        auto oldest = entries.end();
+        for (auto entry = entries.begin(); entry != entries.end(); ++entry) {
+            const long handles = entry->second.surface ? entry->second.surface.use_count() : entry->second.texture.use_count();
+            if (handles == 1 && (oldest == entries.end() || entry->second.lastUse < oldest->second.lastUse)) {
+                oldest = entry;
+            }
+        }
+
+        //Everything left is in use, the budget is exceeded until handles are released
+        if (oldest == entries.end()) {
+            break;
+        }
+        used -= oldest->second.bytes;
+        entries.erase(oldest);
+    }
+}
+
+/*-----*
+Objects
+-------*/
+
+//Images and textures shared by path
+extern LAssetCache gAssetCache;
+
+#endif //LASSETCACHE_H
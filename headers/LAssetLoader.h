@@ -0,0 +1,220 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LASSETLOADER_H
+#define LASSETLOADER_H
+#include <SDL.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LHighResTimer.h"
+
+//Most loading threads started, past this disk bandwidth runs out first
+inline constexpr int MAX_ASSET_WORKERS = 8;
+
+//Loads assets as a task graph, file reading and decoding on a worker pool and GPU uploads on the calling thread
+class LAssetLoader {
+public:
+    //Initializes variables
+    LAssetLoader();
+
+    //Adds a task, work runs on a worker and finish on the render thread once work succeeded,
+    //either may be empty, the task starts once every dependency finished, returns the task's id
+    int addTask(const std::string& name, std::function<bool()> work, std::function<bool()> finish = nullptr, std::initializer_list<int> dependencies = {});
+
+    //Runs every task to completion, returns false if any failed
+    bool run();
+
+    //Prints how long every task took
+    void printTimings() const;
+
+private:
+    //A node of the graph
+    struct Task {
+        std::string name;
+        std::function<bool()> work;
+        std::function<bool()> finish;
+
+        //Tasks waiting on this one and how many this one still waits on
+        std::vector<int> dependents;
+        int waiting;
+
+        //Whether work, finish or a dependency failed
+        bool failed;
+
+        //Timings in nanoseconds, the last one since the run started
+        Uint64 workTime;
+        Uint64 finishTime;
+        Uint64 doneAt;
+    };
+
+    //Takes ready tasks off the queue until the run is over
+    void workerLoop();
+
+    //Hands a task whose dependencies finished to the workers, or straight back when it has no work
+    void schedule(int task);
+
+    //The graph
+    std::vector<Task> mTasks;
+
+    //Tasks ready for a worker and tasks ready for their finish step
+    std::deque<int> mReady;
+    std::deque<int> mWorked;
+
+    //Guards both queues
+    std::mutex mMutex;
+    std::condition_variable mReadyCondition;
+    std::condition_variable mWorkedCondition;
+
+    //Tells workers to leave
+    bool mStopping;
+
+    //Time since the run started
+    LHighResTimer mTimer;
+};
+
+/*--------------------*
+LAssetLoader functions
+----------------------*/
+
+//Initializes variables
+inline LAssetLoader::LAssetLoader() {
+    mStopping = false;
+}
+
+//Adds a task, returns the task's id
+inline int LAssetLoader::addTask(const std::string& name, std::function<bool()> work, std::function<bool()> finish, const std::initializer_list<int> dependencies) {
+    const int id = static_cast<int>(mTasks.size());
+    mTasks.push_back({name, std::move(work), std::move(finish), {}, static_cast<int>(dependencies.size()), false, 0, 0, 0});
+    for (const int dependency : dependencies) {
+        mTasks[dependency].dependents.push_back(id);
+    }
+    return id;
+}
+
+//Runs every task to completion
+inline bool LAssetLoader::run() {
+    mTimer.start();
+
+    //One worker per core, no more than there are tasks
+    const int workers = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, std::min(MAX_ASSET_WORKERS, std::max(1, static_cast<int>(mTasks.size()))));
+    mStopping = false;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < workers; ++i) {
+        threads.emplace_back(&LAssetLoader::workerLoop, this);
+    }
+
+    //Start from the tasks nothing is waiting on
+    {
+        std::lock_guard lock(mMutex);
+        for (int i = 0; i < static_cast<int>(mTasks.size()); ++i) {
+            if (mTasks[i].waiting == 0) {
+                schedule(i);
+            }
+        }
+    }
+
+    //Finish tasks as workers hand them back, releasing their dependents
+    bool success = true;
+    for (size_t finished = 0; finished < mTasks.size(); ++finished) {
+        int id;
+        {
+            std::unique_lock lock(mMutex);
+            mWorkedCondition.wait(lock, [this] { return !mWorked.empty(); });
+            id = mWorked.front();
+            mWorked.pop_front();
+        }
+
+        //Texture creation and the like must happen on the render thread
+        Task& task = mTasks[id];
+        if (!task.failed && task.finish) {
+            const Uint64 finishStart = mTimer.getTicks();
+            task.failed = !task.finish();
+            task.finishTime = mTimer.getTicks() - finishStart;
+        }
+        task.doneAt = mTimer.getTicks();
+        success = success && !task.failed;
+
+        //Dependents of a failed task are skipped
+        std::lock_guard lock(mMutex);
+        for (const int dependent : task.dependents) {
+            mTasks[dependent].failed = mTasks[dependent].failed || task.failed;
+            if (--mTasks[dependent].waiting == 0) {
+                schedule(dependent);
+            }
+        }
+    }
+
+    //Let the workers go
+    {
+        std::lock_guard lock(mMutex);
+        mStopping = true;
+    }
+    mReadyCondition.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return success;
+}
+
+//Prints how long every task took
+inline void LAssetLoader::printTimings() const {
+    Uint64 total = 0;
+    for (const Task& task : mTasks) {
+        printf("Loaded %-12s %s work %7.2f ms, finish %7.2f ms, done at %7.2f ms\n", task.name.c_str(), task.failed ? "(failed)" : "        ",
+            static_cast<double>(task.workTime) / NANOSECONDS_PER_MILLISECOND,
+            static_cast<double>(task.finishTime) / NANOSECONDS_PER_MILLISECOND,
+            static_cast<double>(task.doneAt) / NANOSECONDS_PER_MILLISECOND);
+        total = std::max(total, task.doneAt);
+    }
+    printf("Loaded %zu assets in %.2f ms\n", mTasks.size(), static_cast<double>(total) / NANOSECONDS_PER_MILLISECOND);
+}
+
+//Takes ready tasks off the queue until the run is over
+inline void LAssetLoader::workerLoop() {
+    std::unique_lock lock(mMutex);
+    while (true) {
+        mReadyCondition.wait(lock, [this] { return mStopping || !mReady.empty(); });
+        if (mReady.empty()) {
+            return;
+        }
+        const int id = mReady.front();
+        mReady.pop_front();
+
+        //Read and decode without holding the lock
+        lock.unlock();
+        Task& task = mTasks[id];
+        const Uint64 workStart = mTimer.getTicks();
+        const bool worked = task.work();
+        const Uint64 workTime = mTimer.getTicks() - workStart;
+        lock.lock();
+
+        task.failed = !worked;
+        task.workTime = workTime;
+        mWorked.push_back(id);
+        mWorkedCondition.notify_one();
+    }
+}
+
+//Hands a task whose dependencies finished to the workers, caller holds the lock
+inline void LAssetLoader::schedule(const int task) {
+    //Nothing to do off the render thread
+    if (mTasks[task].failed || !mTasks[task].work) {
+        mWorked.push_back(task);
+        mWorkedCondition.notify_one();
+    }
+    else {
+        mReady.push_back(task);
+        mReadyCondition.notify_one();
+    }
+}
+
+#endif //LASSETLOADER_H
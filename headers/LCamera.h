@@ -6,9 +6,6 @@
 #define LCAMERA_H
 #include <SDL_rect.h>
 
-extern const int LEVEL_WIDTH;
-extern const int LEVEL_HEIGHT;
-
 class LCamera {
     public:
         //Initialize variables
@@ -0,0 +1,341 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LCHUNKSTREAMER_H
+#define LCHUNKSTREAMER_H
+#include <SDL.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "global.h"
+#include "LCamera.h"
+#include "LMapFile.h"
+#include "LProfiler.h"
+#include "LSPSCQueue.h"
+#include "LTileMap.h"
+
+//Chunks kept in memory at once while streaming
+inline constexpr int STREAM_RESIDENT_CHUNKS = 256;
+
+//Chunks loaded around the camera in every direction
+inline constexpr int STREAM_MARGIN_CHUNKS = 1;
+
+//How far ahead of the dot's movement chunks are fetched, in seconds
+inline constexpr float STREAM_PREFETCH_SECONDS = 1.f;
+
+//Requests and finished chunks in flight between the threads
+inline constexpr size_t STREAM_QUEUE_SIZE = 64;
+
+//Loads and unloads the chunks of a binary map around the camera on a worker thread
+class LChunkStreamer {
+public:
+    //Initializes variables
+    LChunkStreamer();
+
+    //Stops the worker
+    ~LChunkStreamer();
+
+    //Checks if a map has more chunks than stay resident
+    static bool shouldStream(const std::string& path);
+
+    //Maps the file, sizes the map for streaming and starts the worker
+    bool open(const std::string& path, LTileMap& map);
+
+    //Loads the chunks around the camera right away, for startup
+    void prime(LTileMap& map, LCamera& camera);
+
+    //Takes in finished chunks, drops far ones and requests near ones, never waits on the worker
+    void update(LTileMap& map, LCamera& camera, float velX, float velY);
+
+    //Stops the worker and unmaps the file
+    void close();
+
+    //Gets streaming state
+    bool isOpen() const;
+    int getPendingChunks() const;
+
+private:
+    //Residency of a chunk as the main thread sees it
+    enum ChunkState : Uint8 {
+        CHUNK_UNLOADED,
+        CHUNK_PENDING,
+        CHUNK_LOADED
+    };
+
+    //A chunk decoded by the worker
+    struct LoadedChunk {
+        int chunk;
+        std::array<Uint16, TILES_PER_CHUNK> tiles;
+    };
+
+    //Decodes requested chunks until told to quit
+    void workerLoop();
+
+    //Decodes one chunk, unreadable chunks come back as walls
+    void readChunk(int chunk, Uint16* tiles) const;
+
+    //Gets the chunks around the camera and ahead of the movement, in chunk space
+    SDL_Rect getChunkArea(const LTileMap& map, LCamera& camera, float velX, float velY, int margin) const;
+
+    //Hands a chunk to the map, or forgets it when there is no room
+    void insertChunk(LTileMap& map, int chunk, const Uint16* tiles);
+
+    //The mapped file, only read by the worker once it runs
+    LMapFile mFile;
+
+    //Decoding thread and its wake up counter
+    std::thread mWorker;
+    std::atomic<bool> mQuit;
+    std::atomic<int> mRequestSignal;
+
+    //Chunk requests to the worker and decoded chunks back
+    LSPSCQueue<int, STREAM_QUEUE_SIZE> mRequests;
+    LSPSCQueue<LoadedChunk, STREAM_QUEUE_SIZE> mCompleted;
+
+    //State of every chunk and the loaded ones, main thread only
+    std::vector<Uint8> mStates;
+    std::vector<int> mResident;
+
+    //Requests not back yet
+    int mPending;
+};
+
+/*----------------------*
+LChunkStreamer functions
+------------------------*/
+
+//Initializes variables
+inline LChunkStreamer::LChunkStreamer() : mQuit(false), mRequestSignal(0) {
+    mPending = 0;
+}
+
+//Stops the worker
+inline LChunkStreamer::~LChunkStreamer() {
+    close();
+}
+
+//Checks if a map has more chunks than stay resident
+inline bool LChunkStreamer::shouldStream(const std::string& path) {
+    //Only binary maps can be read a chunk at a time
+    LMapFile file;
+    if (!path.ends_with(".lmap") || !file.open(path)) {
+        return false;
+    }
+
+    const int chunkColumns = (file.getWidth() + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    const int chunkRows = (file.getHeight() + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    return static_cast<long long>(chunkColumns) * chunkRows > STREAM_RESIDENT_CHUNKS;
+}
+
+//Maps the file, sizes the map for streaming and starts the worker
+inline bool LChunkStreamer::open(const std::string& path, LTileMap& map) {
+    //Stop preexisting stream
+    close();
+
+    if (!mFile.open(path)) {
+        return false;
+    }
+
+    //File chunks are streamed as they are, so they must match the map's
+    if (mFile.getChunkSize() != TILE_CHUNK_SIZE || mFile.getTileWidth() != TILE_WIDTH || mFile.getTileHeight() != TILE_HEIGHT) {
+        printf("Unable to stream %s: needs %d tile chunks of %dx%d tiles!\n", path.c_str(), TILE_CHUNK_SIZE, TILE_WIDTH, TILE_HEIGHT);
+        mFile.close();
+        return false;
+    }
+
+    //Nothing is resident to begin with
+    map.free();
+    map.createStreamed(mFile.getWidth(), mFile.getHeight(), STREAM_RESIDENT_CHUNKS);
+    mStates.assign(static_cast<size_t>(map.getChunkColumns()) * map.getChunkRows(), CHUNK_UNLOADED);
+    mResident.clear();
+    mPending = 0;
+
+    //Start decoding
+    mQuit = false;
+    mWorker = std::thread(&LChunkStreamer::workerLoop, this);
+
+    return true;
+}
+
+//Loads the chunks around the camera right away
+inline void LChunkStreamer::prime(LTileMap& map, LCamera& camera) {
+    const SDL_Rect area = getChunkArea(map, camera, 0.f, 0.f, STREAM_MARGIN_CHUNKS);
+    std::vector<Uint16> tiles(TILES_PER_CHUNK);
+    for (int row = area.y; row < area.y + area.h; ++row) {
+        for (int column = area.x; column < area.x + area.w; ++column) {
+            const int chunk = row * map.getChunkColumns() + column;
+            if (mStates[chunk] == CHUNK_UNLOADED) {
+                readChunk(chunk, tiles.data());
+                insertChunk(map, chunk, tiles.data());
+            }
+        }
+    }
+}
+
+//Takes in finished chunks, drops far ones and requests near ones
+inline void LChunkStreamer::update(LTileMap& map, LCamera& camera, const float velX, const float velY) {
+    PROFILE_ZONE("streaming");
+
+    if (!isOpen()) {
+        return;
+    }
+
+    //Chunks to fetch, and a wider area kept so chunks on the edge do not bounce in and out
+    const SDL_Rect wanted = getChunkArea(map, camera, velX, velY, STREAM_MARGIN_CHUNKS);
+    const SDL_Rect kept = getChunkArea(map, camera, velX, velY, STREAM_MARGIN_CHUNKS + 1);
+
+    //Drop resident chunks that left the kept area
+    for (int i = static_cast<int>(mResident.size()) - 1; i >= 0; --i) {
+        const SDL_Point position = {mResident[i] % map.getChunkColumns(), mResident[i] / map.getChunkColumns()};
+        if (!SDL_PointInRect(&position, &kept)) {
+            map.unloadChunk(mResident[i]);
+            mStates[mResident[i]] = CHUNK_UNLOADED;
+            mResident[i] = mResident.back();
+            mResident.pop_back();
+        }
+    }
+
+    //Take in what the worker finished, unless the camera already moved away
+    LoadedChunk loaded;
+    while (mCompleted.pop(loaded)) {
+        --mPending;
+        mStates[loaded.chunk] = CHUNK_UNLOADED;
+        const SDL_Point position = {loaded.chunk % map.getChunkColumns(), loaded.chunk / map.getChunkColumns()};
+        if (SDL_PointInRect(&position, &kept)) {
+            insertChunk(map, loaded.chunk, loaded.tiles.data());
+        }
+    }
+
+    //Ask for missing chunks until the queue is full
+    bool requested = false;
+    for (int row = wanted.y; row < wanted.y + wanted.h; ++row) {
+        for (int column = wanted.x; column < wanted.x + wanted.w; ++column) {
+            const int chunk = row * map.getChunkColumns() + column;
+            if (mStates[chunk] != CHUNK_UNLOADED) {
+                continue;
+            }
+            if (!mRequests.push(chunk)) {
+                break;
+            }
+            mStates[chunk] = CHUNK_PENDING;
+            ++mPending;
+            requested = true;
+        }
+    }
+
+    //Wake the worker
+    if (requested) {
+        ++mRequestSignal;
+        mRequestSignal.notify_one();
+    }
+}
+
+//Stops the worker and unmaps the file
+inline void LChunkStreamer::close() {
+    if (mWorker.joinable()) {
+        mQuit = true;
+        ++mRequestSignal;
+        mRequestSignal.notify_one();
+        mWorker.join();
+    }
+
+    //Forget whatever was in flight
+    int request;
+    while (mRequests.pop(request)) {
+    }
+    LoadedChunk loaded;
+    while (mCompleted.pop(loaded)) {
+    }
+
+    mFile.close();
+    mStates.clear();
+    mResident.clear();
+    mPending = 0;
+}
+
+//Gets streaming state
+inline bool LChunkStreamer::isOpen() const {
+    return mWorker.joinable();
+}
+
+inline int LChunkStreamer::getPendingChunks() const {
+    return mPending;
+}
+
+//Decodes requested chunks until told to quit
+inline void LChunkStreamer::workerLoop() {
+    LoadedChunk loaded;
+    while (!mQuit) {
+        //Sleep until the main thread signals, checking the queue after reading the signal so no wake up is missed
+        const int signal = mRequestSignal.load();
+        if (!mRequests.pop(loaded.chunk)) {
+            mRequestSignal.wait(signal);
+            continue;
+        }
+
+        //Reading the mapping is where the disk is touched
+        readChunk(loaded.chunk, loaded.tiles.data());
+
+        //Wait for room rather than drop finished work
+        while (!mCompleted.push(loaded) && !mQuit) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//Decodes one chunk, unreadable chunks come back as walls
+inline void LChunkStreamer::readChunk(const int chunk, Uint16* tiles) const {
+    if (!mFile.readChunk(0, chunk, tiles)) {
+        printf("Warning: Corrupt map chunk %d is solid!\n", chunk);
+        std::fill(tiles, tiles + TILES_PER_CHUNK, static_cast<Uint16>(TILE_CENTER));
+        return;
+    }
+
+    //Unknown tiles would index past the sprite clips
+    for (int i = 0; i < TILES_PER_CHUNK; ++i) {
+        if (tiles[i] >= TOTAL_TILE_SPRITES) {
+            tiles[i] = TILE_CENTER;
+        }
+    }
+}
+
+//Gets the chunks around the camera and ahead of the movement
+inline SDL_Rect LChunkStreamer::getChunkArea(const LTileMap& map, LCamera& camera, const float velX, const float velY, const int margin) const {
+    //Stretch the camera along the direction of travel
+    const int aheadX = static_cast<int>(velX * STREAM_PREFETCH_SECONDS);
+    const int aheadY = static_cast<int>(velY * STREAM_PREFETCH_SECONDS);
+    const int left = camera.getX() + std::min(0, aheadX);
+    const int right = camera.getX() + camera.getWidth() + std::max(0, aheadX);
+    const int top = camera.getY() + std::min(0, aheadY);
+    const int bottom = camera.getY() + camera.getHeight() + std::max(0, aheadY);
+
+    //Convert to chunks, clamped to the map
+    const int chunkWidth = TILE_CHUNK_SIZE * TILE_WIDTH;
+    const int chunkHeight = TILE_CHUNK_SIZE * TILE_HEIGHT;
+    const int firstColumn = std::max(0, left / chunkWidth - margin);
+    const int lastColumn = std::min(map.getChunkColumns() - 1, right / chunkWidth + margin);
+    const int firstRow = std::max(0, top / chunkHeight - margin);
+    const int lastRow = std::min(map.getChunkRows() - 1, bottom / chunkHeight + margin);
+    return {firstColumn, firstRow, std::max(0, lastColumn - firstColumn + 1), std::max(0, lastRow - firstRow + 1)};
+}
+
+//Hands a chunk to the map, or forgets it when there is no room
+inline void LChunkStreamer::insertChunk(LTileMap& map, const int chunk, const Uint16* tiles) {
+    if (map.loadChunk(chunk, tiles)) {
+        mStates[chunk] = CHUNK_LOADED;
+        mResident.push_back(chunk);
+    }
+}
+
+/*-----*
+Objects
+-------*/
+
+//Streams the level around the camera when it is too large to keep resident
+extern LChunkStreamer gChunkStreamer;
+
+#endif //LCHUNKSTREAMER_H
@@ -5,19 +5,19 @@
 #ifndef LDOT_H
 #define LDOT_H
 #include <SDL.h>
-#include "LTile.h"
+#include "LTileMap.h"
 #include "Circle.h"
 #include "LParticle.h"
 #include "DeltaTime.h"
 #include "global.h"
-#include "LTexture.h"
-
-extern const int LEVEL_WIDTH;
-extern const int LEVEL_HEIGHT;
+#include "LTextureAtlas.h"
+#include "LProfiler.h"
+#include "LFixed.h"
+#include "LStateHash.h"
 
 inline constexpr int TOTAL_PARTICLES = 20;
 
-bool touchesWall(const Circle* circle, LTile* tiles[]);
+int sweepCircle(const Circle* circle, int distance, bool vertical, const LTileMap& map);
 
 //The dot that will move around on the screen
 class LDot {
@@ -32,23 +32,23 @@ public:
     //Initializes the variables
     LDot(int x, int y);
 
-    //Deallocate dot
-    ~LDot();
-
     //Takes key presses and adjusts the dot's velocity
     void handleEvent(const SDL_Event &e);
 
+    //Checks if a key steers the dot
+    static bool isControlKey(SDL_Keycode key);
+
     //Moves the dot
-    void move(LTile *tiles[]);
+    void move(const LTileMap& map);
 
-    //Load texture for dot
-    bool loadTexture(SDL_Renderer *mRenderer, const std::string &path);
+    //Set texture for dot from an atlas
+    void setTexture(const LTextureRegion& texture);
 
     //Deallocate texture
     void free();
 
-    //Centers the camera over the dot
-    void setCamera(LCamera& camera);
+    //Centers the camera over the dot, keeping it inside the map
+    void setCamera(LCamera& camera, const LTileMap& map);
 
     //Shows the dot of the screen
     void render(SDL_Renderer* mRenderer, LCamera& camera);
@@ -59,21 +59,35 @@ public:
     //Position accessors
     int getPosX() const;
     int getPosY() const;
+
+    //Velocity accessors, in pixels per second
+    float getVelX() const;
+    float getVelY() const;
+
+    //Mixes position and velocity into a hash, bit identical across builds in fixed point mode
+    void hashState(LStateHash& hash) const;
 private:
-    //The particles
-    Particle* particles[TOTAL_PARTICLES];
+    //First of the dot's particle slots in the pool
+    int mParticles;
 
     //Shows the particles
     void renderParticles(SDL_Renderer *mRenderer, int camX, int camY);
 
     //The X and Y offsets of the dot
-    float mPosX, mPosY;
+    Real mPosX, mPosY;
+
+    //The offsets before the last move, for interpolated rendering
+    Real mPrevPosX, mPrevPosY;
+
+    //Offsets blended between the last two moves
+    float getRenderPosX() const;
+    float getRenderPosY() const;
 
     //The velocity of the dot
-    float mVelX, mVelY;
+    Real mVelX, mVelY;
 
     //The dot's texture
-    LTexture mDotTexture;
+    LTextureRegion mDotTexture;
 
     //Dot's collision circle
     Circle mCollider;
@@ -91,6 +105,8 @@ inline LDot::LDot(const int x, const int y) {
     //Initialize the offsets
     mPosX = x;
     mPosY = y;
+    mPrevPosX = mPosX;
+    mPrevPosY = mPosY;
 
     //Create the necessary SDL_Rects
     mCollider.r = DOT_WIDTH / 2;
@@ -99,21 +115,13 @@ inline LDot::LDot(const int x, const int y) {
     mVelX = 0;
     mVelY = 0;
 
-    //Initialize particles
-    for (int i = 0; i < TOTAL_PARTICLES; i++) {
-        particles[i] = new Particle(mPosX, mPosY, 20);
-    }
+    //Particle slots are reserved on first render
+    mParticles = -1;
 
     //Initialize colliders relative to position
     shiftColliders();
 }
 
-inline LDot::~LDot() {
-    for (int i = 0; i < TOTAL_PARTICLES; i++) {
-        delete particles[i];
-    }
-}
-
 //Takes key presses and adjusts the dot's velocity
 inline void LDot::handleEvent(const SDL_Event &e) {
     if (e.type == SDL_JOYAXISMOTION) {
@@ -148,8 +156,8 @@ inline void LDot::handleEvent(const SDL_Event &e) {
                 else yDir = 0;
             }
         }
-        mVelX = DOT_VEL * xDir;
-        mVelY = DOT_VEL * yDir;
+        mVelX = Real(DOT_VEL * xDir);
+        mVelY = Real(DOT_VEL * yDir);
     }
     //If a key was pressed
     else if (e.type == SDL_KEYDOWN && e.key.repeat == 0) {
@@ -192,38 +200,45 @@ inline void LDot::handleEvent(const SDL_Event &e) {
     }
 }
 
+//Checks if a key steers the dot
+inline bool LDot::isControlKey(const SDL_Keycode key) {
+    return key == SDLK_UP || key == SDLK_DOWN || key == SDLK_LEFT || key == SDLK_RIGHT;
+}
+
 //Moves the dot
-inline void LDot::move(LTile* tiles[]) {
+inline void LDot::move(const LTileMap& map) {
+    PROFILE_ZONE("LDot::move");
 
     //Delta time
-    const float delta = gDeltaTime.getDeltaTime();
+    const Real delta = Real(gDeltaTime.getDeltaTime());
 
-    //Move the dot left or right
-    mPosX += mVelX * delta;
-    shiftColliders();
-
-    //If the dot went too far to the left or right
-    if ((mPosX - mCollider.r < 0) || (mPosX + mCollider.r > LEVEL_WIDTH) || touchesWall(&mCollider, tiles)) {
-        //Move back
-        mPosX -= mVelX * delta;
-        shiftColliders();
-    }
+    //Remember where the dot was for interpolation
+    mPrevPosX = mPosX;
+    mPrevPosY = mPosY;
 
-    //Move the dot up or down
-    mPosY += mVelY * delta;
+    //Move the dot left or right, stopping against the first wall in the way however fast it goes
+    const Real targetX = mPosX + mVelX * delta;
+    const int travelX = static_cast<int>(targetX) - mCollider.x;
+    const int reachX = sweepCircle(&mCollider, travelX, false, map);
+    mPosX = reachX == travelX ? targetX : Real(mCollider.x + reachX);
     shiftColliders();
 
-    //If the dot went too far up or down
-    if ((mPosY - mCollider.r < 0.f) || (mPosY + mCollider.r > LEVEL_HEIGHT) || touchesWall(&mCollider, tiles)) {
-        //Move back
-        mPosY -= mVelY * delta;
-        shiftColliders();
-    }
+    //Move the dot up or down from there, so a blocked axis slides along the wall
+    const Real targetY = mPosY + mVelY * delta;
+    const int travelY = static_cast<int>(targetY) - mCollider.y;
+    const int reachY = sweepCircle(&mCollider, travelY, true, map);
+    mPosY = reachY == travelY ? targetY : Real(mCollider.y + reachY);
+    shiftColliders();
 }
 
-//Load texture for dot
-inline bool LDot::loadTexture(SDL_Renderer* mRenderer, const std::string &path) {
-    return mDotTexture.loadFromFile(mRenderer, path);
+//Set texture for dot from an atlas
+inline void LDot::setTexture(const LTextureRegion& texture) {
+    mDotTexture = texture;
+
+    //Claim particle slots before agents fill the pool
+    if (mParticles < 0) {
+        mParticles = gParticlePool.addEmitter(TOTAL_PARTICLES);
+    }
 }
 
 //Deallocate texture
@@ -231,10 +246,10 @@ inline void LDot::free() {
     mDotTexture.free();
 }
 
-inline void LDot::setCamera(LCamera& camera) {
+inline void LDot::setCamera(LCamera& camera, const LTileMap& map) {
     //Center the camera over the dot
-    camera.updatePosX(mPosX - camera.getWidth() / 2);
-    camera.updatePosY(mPosY - camera.getHeight() / 2);
+    camera.updatePosX(getRenderPosX() - camera.getWidth() / 2);
+    camera.updatePosY(getRenderPosY() - camera.getHeight() / 2);
 
     //Keep the camera in bounds
     if (camera.getX() < 0) {
@@ -243,11 +258,11 @@ inline void LDot::setCamera(LCamera& camera) {
     if (camera.getY() < 0) {
         camera.updatePosY(0);
     }
-    if (camera.getX() > LEVEL_WIDTH - camera.getWidth()) {
-        camera.updatePosX(LEVEL_WIDTH - camera.getWidth());
+    if (camera.getX() > map.getLevelWidth() - camera.getWidth()) {
+        camera.updatePosX(map.getLevelWidth() - camera.getWidth());
     }
-    if (camera.getY() > LEVEL_HEIGHT - camera.getHeight()) {
-        camera.updatePosY(LEVEL_HEIGHT - camera.getHeight());
+    if (camera.getY() > map.getLevelHeight() - camera.getHeight()) {
+        camera.updatePosY(map.getLevelHeight() - camera.getHeight());
     }
 }
 
@@ -257,7 +272,7 @@ inline void LDot::render(SDL_Renderer* mRenderer, LCamera& camera) {
     renderParticles(mRenderer, camera.getX(), camera.getY());
 
     //Show the dot
-    mDotTexture.render(mRenderer, mPosX - mCollider.r - camera.getX(), mPosY - mCollider.r - camera.getY());
+    gSpriteBatch.draw(mRenderer, mDotTexture, getRenderPosX() - mCollider.r - camera.getX(), getRenderPosY() - mCollider.r - camera.getY());
 }
 
 //Gets collision circle
@@ -267,32 +282,62 @@ inline Circle& LDot::getCollider() {
 
 //Moves the collision circle relative to the dot's offset
 inline void LDot::shiftColliders() {
-    mCollider.x = mPosX;
-    mCollider.y = mPosY;
+    mCollider.x = static_cast<int>(mPosX);
+    mCollider.y = static_cast<int>(mPosY);
 }
 
 inline int LDot::getPosX() const{
-    return mPosX;
+    return static_cast<int>(mPosX);
 }
 
 inline int LDot::getPosY() const {
-    return mPosY;
+    return static_cast<int>(mPosY);
+}
+
+inline float LDot::getVelX() const {
+    return static_cast<float>(mVelX);
+}
+
+inline float LDot::getVelY() const {
+    return static_cast<float>(mVelY);
+}
+
+//Mixes position and velocity into a hash
+inline void LDot::hashState(LStateHash& hash) const {
+    hash.add(mPosX);
+    hash.add(mPosY);
+    hash.add(mVelX);
+    hash.add(mVelY);
+}
+
+//Offsets blended between the last two moves
+inline float LDot::getRenderPosX() const {
+    const float alpha = gDeltaTime.getAlpha();
+    return static_cast<float>(mPrevPosX) + static_cast<float>(mPosX - mPrevPosX) * alpha;
+}
+
+inline float LDot::getRenderPosY() const {
+    const float alpha = gDeltaTime.getAlpha();
+    return static_cast<float>(mPrevPosY) + static_cast<float>(mPosY - mPrevPosY) * alpha;
 }
 
 inline void LDot::renderParticles(SDL_Renderer* mRenderer, const int camX, const int camY) {
-    //Go through particles
-    for (int i = 0; i < TOTAL_PARTICLES; ++i) {
-        //Delete and replace dead particles
-        if (particles[i]->isDead()) {
-            delete particles[i];
-            particles[i] = new Particle(mPosX, mPosY, 20);
+    PROFILE_ZONE("particles");
+
+    //Reserve particle slots
+    if (mParticles < 0) {
+        mParticles = gParticlePool.addEmitter(TOTAL_PARTICLES);
+        if (mParticles < 0) {
+            return;
         }
     }
 
-    //Show particles
-    for (int i = 0; i < TOTAL_PARTICLES; ++i) {
-        particles[i]->render(mRenderer, camX, camY);
-    }
+    //Replace dead particles in place
+    gParticlePool.emit(mParticles, TOTAL_PARTICLES, getRenderPosX(), getRenderPosY(), 20, &gShimmerTexture);
+
+    //Show particles, then age them
+    gParticlePool.render(mRenderer, mParticles, TOTAL_PARTICLES, camX, camY);
+    gParticlePool.update(mParticles, TOTAL_PARTICLES);
 }
 
 /*-----*
@@ -0,0 +1,155 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LFIXED_H
+#define LFIXED_H
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <limits>
+
+//48.16 fixed point number, integer math only so every compiler and processor gets the same bits,
+//holds far more than any level's pixels in steps of 1/65536
+class LFixed {
+public:
+    //Bits after the point
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr int64_t ONE = int64_t{1} << FRACTION_BITS;
+
+    //Initializes variables
+    constexpr LFixed();
+
+    //Whole numbers convert exactly
+    constexpr LFixed(int value);
+
+    //Floats round to the nearest step, once on the way in so the math after is exact
+    explicit LFixed(float value);
+
+    //Wraps raw bits
+    static constexpr LFixed fromRaw(int64_t raw);
+
+    //Gets raw bits
+    constexpr int64_t getRaw() const;
+
+    //Rounds down to a whole number
+    constexpr explicit operator int() const;
+
+    //Nearest float, for rendering
+    explicit operator float() const;
+
+    //Arithmetic, products and quotients are split so their intermediates stay in 64 bits,
+    //dividing by zero gives the largest number of the dividend's sign
+    constexpr LFixed operator+(LFixed other) const;
+    constexpr LFixed operator-(LFixed other) const;
+    constexpr LFixed operator-() const;
+    constexpr LFixed operator*(LFixed other) const;
+    constexpr LFixed operator/(LFixed other) const;
+    constexpr LFixed& operator+=(LFixed other);
+    constexpr LFixed& operator-=(LFixed other);
+    constexpr LFixed& operator*=(LFixed other);
+    constexpr LFixed& operator/=(LFixed other);
+
+    //Comparisons
+    constexpr bool operator==(const LFixed& other) const = default;
+    constexpr std::strong_ordering operator<=>(const LFixed& other) const = default;
+
+private:
+    //The number times 65536
+    int64_t mRaw;
+};
+
+//Number type of the dot's physics, fixed point when built for lockstep replays
+#ifdef FIXED_POINT_PHYSICS
+using Real = LFixed;
+#else
+using Real = float;
+#endif
+
+/*---------------*
+LFixed functions
+-----------------*/
+
+//Initializes variables
+constexpr LFixed::LFixed() {
+    mRaw = 0;
+}
+
+//Whole numbers convert exactly
+constexpr LFixed::LFixed(const int value) {
+    mRaw = static_cast<int64_t>(value) * ONE;
+}
+
+//Floats round to the nearest step
+inline LFixed::LFixed(const float value) {
+    mRaw = std::llround(static_cast<double>(value) * ONE);
+}
+
+//Wraps raw bits
+constexpr LFixed LFixed::fromRaw(const int64_t raw) {
+    LFixed fixed;
+    fixed.mRaw = raw;
+    return fixed;
+}
+
+//Gets raw bits
+constexpr int64_t LFixed::getRaw() const {
+    return mRaw;
+}
+
+//Rounds down to a whole number, shifting negative numbers is arithmetic since C++20
+constexpr LFixed::operator int() const {
+    return static_cast<int>(mRaw >> FRACTION_BITS);
+}
+
+//Nearest float
+inline LFixed::operator float() const {
+    return static_cast<float>(static_cast<double>(mRaw) / ONE);
+}
+
+constexpr LFixed LFixed::operator+(const LFixed other) const {
+    return fromRaw(mRaw + other.mRaw);
+}
+
+constexpr LFixed LFixed::operator-(const LFixed other) const {
+    return fromRaw(mRaw - other.mRaw);
+}
+
+constexpr LFixed LFixed::operator-() const {
+    return fromRaw(-mRaw);
+}
+
+//Whole part times the other number, plus the fraction part's product shifted down, the same floor as one wide product
+constexpr LFixed LFixed::operator*(const LFixed other) const {
+    const int64_t whole = mRaw >> FRACTION_BITS;
+    const int64_t fraction = mRaw & (ONE - 1);
+    return fromRaw(whole * other.mRaw + (fraction * other.mRaw >> FRACTION_BITS));
+}
+
+//Whole quotient, plus the remainder's quotient after the point, the same truncation as one wide quotient
+constexpr LFixed LFixed::operator/(const LFixed other) const {
+    if (other.mRaw == 0) {
+        return fromRaw(mRaw > 0 ? std::numeric_limits<int64_t>::max() : mRaw < 0 ? std::numeric_limits<int64_t>::min() : 0);
+    }
+    const int64_t whole = mRaw / other.mRaw;
+    const int64_t remainder = mRaw % other.mRaw;
+    return fromRaw(whole * ONE + remainder * ONE / other.mRaw);
+}
+
+constexpr LFixed& LFixed::operator+=(const LFixed other) {
+    return *this = *this + other;
+}
+
+constexpr LFixed& LFixed::operator-=(const LFixed other) {
+    return *this = *this - other;
+}
+
+constexpr LFixed& LFixed::operator*=(const LFixed other) {
+    return *this = *this * other;
+}
+
+constexpr LFixed& LFixed::operator/=(const LFixed other) {
+    return *this = *this / other;
+}
+
+#endif //LFIXED_H
@@ -0,0 +1,188 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LFRAMEPACER_H
+#define LFRAMEPACER_H
+#include <SDL.h>
+#include "LHighResTimer.h"
+
+//Default time before a deadline where sleeping hands over to spinning
+inline constexpr Uint64 DEFAULT_SPIN_THRESHOLD = 2 * NANOSECONDS_PER_MILLISECOND;
+
+//The ways frames can be paced
+enum PacingMode {
+    PACE_VSYNC,
+    PACE_CAPPED,
+    PACE_UNCAPPED,
+    TOTAL_PACING_MODES
+};
+
+//Holds frames to a steady rate with a sleep then spin wait
+class LFramePacer {
+public:
+    //Initializes variables
+    LFramePacer();
+
+    //Sets how frames are paced, toggling renderer vsync to match
+    void setMode(SDL_Renderer* mRenderer, PacingMode mode);
+
+    //Sets the frame rate to hold, fractional rates allowed
+    void setTargetFPS(double fps);
+
+    //Sets how long before a deadline sleeping stops and spinning starts
+    void setSpinThreshold(Uint64 nanoseconds);
+
+    //Starts scheduling deadlines from now
+    void start();
+
+    //Waits until the next frame deadline and counts missed ones
+    void waitForNextFrame();
+
+    //Gets pacing state
+    PacingMode getMode() const;
+    Uint64 getFrameBudget() const;
+    Uint64 getMissedDeadlines() const;
+
+private:
+    //The pacing clock
+    LHighResTimer mTimer;
+
+    //The pacing strategy
+    PacingMode mMode;
+
+    //Nanoseconds per frame
+    Uint64 mFrameBudget;
+
+    //Nanoseconds per display refresh, what vsync actually waits on
+    Uint64 mRefreshPeriod;
+
+    //Nanoseconds before the deadline to start spinning
+    Uint64 mSpinThreshold;
+
+    //When the next frame is due
+    Uint64 mNextDeadline;
+
+    //When the last frame was handed out
+    Uint64 mLastFrame;
+
+    //Frames that finished after their deadline
+    Uint64 mMissedDeadlines;
+};
+
+/*--------------------*
+LFramePacer functions
+----------------------*/
+
+//Initializes variables
+inline LFramePacer::LFramePacer() {
+    mMode = PACE_CAPPED;
+    mFrameBudget = NANOSECONDS_PER_SECOND / 60;
+    mRefreshPeriod = mFrameBudget;
+    mSpinThreshold = DEFAULT_SPIN_THRESHOLD;
+    mNextDeadline = 0;
+    mLastFrame = 0;
+    mMissedDeadlines = 0;
+}
+
+//Sets how frames are paced, toggling renderer vsync to match
+inline void LFramePacer::setMode(SDL_Renderer* mRenderer, const PacingMode mode) {
+    mMode = mode;
+
+    //Only vsync mode waits on the display
+    if (SDL_RenderSetVSync(mRenderer, mMode == PACE_VSYNC ? 1 : 0) != 0) {
+        printf("Warning: Unable to change vsync! SDL Error: %s\n", SDL_GetError());
+    }
+
+    //Vsync frames last one refresh of the display the window is on, the frame budget when it is unknown
+    mRefreshPeriod = mFrameBudget;
+    SDL_DisplayMode displayMode;
+    SDL_Window* window = SDL_RenderGetWindow(mRenderer);
+    if (window != nullptr && SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &displayMode) == 0 && displayMode.refresh_rate > 0) {
+        mRefreshPeriod = NANOSECONDS_PER_SECOND / displayMode.refresh_rate;
+    }
+
+    //Restart the schedule from the switch
+    start();
+}
+
+//Sets the frame rate to hold, fractional rates allowed
+inline void LFramePacer::setTargetFPS(const double fps) {
+    mFrameBudget = static_cast<Uint64>(NANOSECONDS_PER_SECOND / fps);
+}
+
+//Sets how long before a deadline sleeping stops and spinning starts
+inline void LFramePacer::setSpinThreshold(const Uint64 nanoseconds) {
+    mSpinThreshold = nanoseconds;
+}
+
+//Starts scheduling deadlines from now
+inline void LFramePacer::start() {
+    mTimer.start();
+    mLastFrame = 0;
+    mNextDeadline = mFrameBudget;
+    mMissedDeadlines = 0;
+}
+
+//Waits until the next frame deadline and counts missed ones
+inline void LFramePacer::waitForNextFrame() {
+    Uint64 now = mTimer.getTicks();
+
+    if (mMode == PACE_CAPPED) {
+        //Frame overran its deadline
+        if (now > mNextDeadline) {
+            ++mMissedDeadlines;
+
+            //Drop the schedule rather than rushing frames to catch up
+            if (now - mNextDeadline > mFrameBudget) {
+                mNextDeadline = now;
+            }
+        }
+        else {
+            //Sleep off the coarse part of the wait, leaving a margin for scheduler wakeup
+            while (mNextDeadline > now + mSpinThreshold) {
+                const Uint64 sleepTime = (mNextDeadline - now - mSpinThreshold) / NANOSECONDS_PER_MILLISECOND;
+                if (sleepTime == 0) {
+                    break;
+                }
+                SDL_Delay(static_cast<Uint32>(sleepTime));
+                now = mTimer.getTicks();
+            }
+
+            //Spin the rest precisely
+            while (now < mNextDeadline) {
+                now = mTimer.getTicks();
+            }
+        }
+        mNextDeadline += mFrameBudget;
+    }
+    else if (mMode == PACE_VSYNC) {
+        //A frame longer than one and a half refreshes skipped a vblank
+        if (mLastFrame != 0 && now - mLastFrame > mRefreshPeriod + mRefreshPeriod / 2) {
+            ++mMissedDeadlines;
+        }
+    }
+
+    mLastFrame = now;
+}
+
+inline PacingMode LFramePacer::getMode() const {
+    return mMode;
+}
+
+inline Uint64 LFramePacer::getFrameBudget() const {
+    return mFrameBudget;
+}
+
+inline Uint64 LFramePacer::getMissedDeadlines() const {
+    return mMissedDeadlines;
+}
+
+/*-----*
+Objects
+-------*/
+
+//Paces the main loop
+extern LFramePacer gFramePacer;
+
+#endif //LFRAMEPACER_H
@@ -0,0 +1,233 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LGLYPHATLAS_H
+#define LGLYPHATLAS_H
+#include <string>
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include "LSpriteBatch.h"
+
+//Printable ASCII range cached in the atlas
+inline constexpr int FIRST_GLYPH = 32;
+inline constexpr int LAST_GLYPH = 126;
+inline constexpr int TOTAL_GLYPHS = LAST_GLYPH - FIRST_GLYPH + 1;
+
+//Width of the atlas texture, glyphs wrap onto new rows past this
+inline constexpr int GLYPH_ATLAS_WIDTH = 512;
+
+//Font glyphs rasterized once into a single texture
+class LGlyphAtlas {
+public:
+    //Initializes variables
+    LGlyphAtlas();
+
+    //Deallocates memory
+    ~LGlyphAtlas();
+
+    //Rasterizes every glyph of the font into the atlas
+    bool loadFromFont(SDL_Renderer* mRenderer, TTF_Font* mFont);
+
+    //Deallocates atlas
+    void free();
+
+    //Queues string at given point as quads in the sprite batch
+    void renderText(SDL_Renderer* mRenderer, const std::string& text, int x, int y, SDL_Color color = {0xFF, 0xFF, 0xFF, 0xFF});
+
+    //Gets dimensions of a string without drawing it
+    int getTextWidth(const std::string& text) const;
+    int getLineHeight() const;
+
+private:
+    //Where a glyph sits in the atlas and how far it moves the pen
+    struct Glyph {
+        SDL_Rect clip;
+        int advance;
+    };
+
+    //The actual hardware texture
+    SDL_Texture* mTexture;
+
+    //Atlas dimensions
+    int mWidth;
+    int mHeight;
+
+    //Font line height
+    int mLineHeight;
+
+    //Glyph lookup table
+    Glyph mGlyphs[TOTAL_GLYPHS];
+};
+
+/*--------------------*
+LGlyphAtlas functions
+----------------------*/
+
+//Initializes variables
+inline LGlyphAtlas::LGlyphAtlas() {
+    mTexture = nullptr;
+    mWidth = 0;
+    mHeight = 0;
+    mLineHeight = 0;
+    for (Glyph& glyph : mGlyphs) {
+        glyph.clip = {0, 0, 0, 0};
+        glyph.advance = 0;
+    }
+}
+
+//Deallocates memory
+inline LGlyphAtlas::~LGlyphAtlas() {
+    free();
+}
+
+//Rasterizes every glyph of the font into the atlas
+inline bool LGlyphAtlas::loadFromFont(SDL_Renderer* mRenderer, TTF_Font* mFont) {
+    //Get rid of preexisting atlas
+    free();
+
+    if (mFont == nullptr) {
+        printf("Unable to build glyph atlas without a font!\n");
+        return false;
+    }
+
+    //Rendered glyphs, kept until they are packed
+    SDL_Surface* glyphSurfaces[TOTAL_GLYPHS] = {};
+
+    //Lay glyphs out in rows
+    mLineHeight = TTF_FontLineSkip(mFont);
+    int penX = 0, penY = 0, rowHeight = 0;
+    for (int i = 0; i < TOTAL_GLYPHS; ++i) {
+        const Uint16 ch = static_cast<Uint16>(FIRST_GLYPH + i);
+
+        //Render glyph in white so color can be modulated per draw
+        SDL_Surface* glyphSurface = TTF_RenderGlyph_Blended(mFont, ch, {0xFF, 0xFF, 0xFF, 0xFF});
+        if (glyphSurface == nullptr) {
+            continue;
+        }
+        glyphSurfaces[i] = glyphSurface;
+
+        //Move to the next row if this glyph does not fit
+        if (penX + glyphSurface->w > GLYPH_ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+
+        mGlyphs[i].clip = {penX, penY, glyphSurface->w, glyphSurface->h};
+        if (TTF_GlyphMetrics(mFont, ch, nullptr, nullptr, nullptr, nullptr, &mGlyphs[i].advance) != 0) {
+            mGlyphs[i].advance = glyphSurface->w;
+        }
+
+        penX += glyphSurface->w + 1;
+        if (glyphSurface->h > rowHeight) {
+            rowHeight = glyphSurface->h;
+        }
+    }
+    mWidth = GLYPH_ATLAS_WIDTH;
+    mHeight = penY + rowHeight;
+
+    //Pack glyphs into one surface
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, mWidth, mHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlasSurface == nullptr) {
+        printf("Unable to create glyph atlas surface! SDL Error: %s\n", SDL_GetError());
+    }
+    else {
+        for (int i = 0; i < TOTAL_GLYPHS; ++i) {
+            if (glyphSurfaces[i] != nullptr) {
+                //Copy alpha as is instead of blending onto the empty atlas
+                SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(glyphSurfaces[i], nullptr, atlasSurface, &mGlyphs[i].clip);
+            }
+        }
+
+        //Create texture from surface pixels
+        mTexture = SDL_CreateTextureFromSurface(mRenderer, atlasSurface);
+        if (mTexture == nullptr) {
+            printf("Unable to create glyph atlas texture! SDL Error: %s\n", SDL_GetError());
+        }
+        else {
+            SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_BLEND);
+        }
+
+        //Get rid of packed surface
+        SDL_FreeSurface(atlasSurface);
+    }
+
+    //Get rid of glyph surfaces
+    for (SDL_Surface* glyphSurface : glyphSurfaces) {
+        if (glyphSurface != nullptr) {
+            SDL_FreeSurface(glyphSurface);
+        }
+    }
+
+    //Return success
+    return mTexture != nullptr;
+}
+
+//Deallocates atlas
+inline void LGlyphAtlas::free() {
+    if (mTexture != nullptr) {
+        SDL_DestroyTexture(mTexture);
+        mTexture = nullptr;
+        mWidth = 0;
+        mHeight = 0;
+    }
+}
+
+//Queues string at given point as quads in the sprite batch
+inline void LGlyphAtlas::renderText(SDL_Renderer* mRenderer, const std::string& text, const int x, const int y, const SDL_Color color) {
+    if (mTexture == nullptr) {
+        return;
+    }
+
+    //Queue a quad per glyph
+    int penX = x, penY = y;
+    for (const char c : text) {
+        if (c == '\n') {
+            penX = x;
+            penY += mLineHeight;
+            continue;
+        }
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) {
+            continue;
+        }
+
+        const Glyph& glyph = mGlyphs[c - FIRST_GLYPH];
+        if (glyph.clip.w > 0 && glyph.clip.h > 0) {
+            gSpriteBatch.draw(mRenderer, mTexture, glyph.clip, {penX, penY, glyph.clip.w, glyph.clip.h}, color);
+        }
+
+        penX += glyph.advance;
+    }
+}
+
+//Gets dimensions of a string without drawing it
+inline int LGlyphAtlas::getTextWidth(const std::string& text) const {
+    int width = 0, lineWidth = 0;
+    for (const char c : text) {
+        if (c == '\n') {
+            lineWidth = 0;
+        }
+        else if (c >= FIRST_GLYPH && c <= LAST_GLYPH) {
+            lineWidth += mGlyphs[c - FIRST_GLYPH].advance;
+        }
+        if (lineWidth > width) {
+            width = lineWidth;
+        }
+    }
+    return width;
+}
+
+inline int LGlyphAtlas::getLineHeight() const {
+    return mLineHeight;
+}
+
+/*-----*
+Objects
+-------*/
+
+//Glyphs of the global font
+extern LGlyphAtlas gFontAtlas;
+
+#endif //LGLYPHATLAS_H
@@ -0,0 +1,161 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LHIGHRESTIMER_H
+#define LHIGHRESTIMER_H
+#include <SDL.h>
+
+//Time unit conversions
+inline constexpr Uint64 NANOSECONDS_PER_SECOND = 1000000000;
+inline constexpr Uint64 NANOSECONDS_PER_MILLISECOND = 1000000;
+
+//Nanosecond timer based on the performance counter
+class LHighResTimer {
+public:
+    //Initializes variables
+    LHighResTimer();
+
+    //The various clock actions
+    void start();
+
+    void stop();
+
+    void pause();
+
+    void unpause();
+
+    //Gets the timer's time in nanoseconds
+    Uint64 getTicks() const;
+
+    //Checks the status of the timer
+    bool isStarted() const;
+
+    bool isPaused() const;
+
+    //Converts performance counter ticks to nanoseconds
+    static Uint64 toNanoseconds(Uint64 counter);
+
+private:
+    //The counter value when the timer started
+    Uint64 mStartCounter;
+
+    //The counter ticks stored when the timer was paused
+    Uint64 mPausedCounter;
+
+    //The timer status
+    bool mPaused;
+    bool mStarted;
+};
+
+/*---------------------*
+LHighResTimer functions
+-----------------------*/
+
+//Initializes variables
+inline LHighResTimer::LHighResTimer() {
+    mStartCounter = 0;
+    mPausedCounter = 0;
+
+    mPaused = false;
+    mStarted = false;
+}
+
+//The various clock actions
+inline void LHighResTimer::start() {
+    //Start the timer
+    mStarted = true;
+
+    //Unpause the timer
+    mPaused = false;
+
+    //Get the current counter value
+    mStartCounter = SDL_GetPerformanceCounter();
+    mPausedCounter = 0;
+}
+
+inline void LHighResTimer::stop() {
+    //Stop the timer
+    mStarted = false;
+
+    //Unpause the timer
+    mPaused = false;
+
+    //Clear counter variables
+    mStartCounter = 0;
+    mPausedCounter = 0;
+}
+
+inline void LHighResTimer::pause() {
+    //If the timer is running and isn't already paused
+    if (mStarted && !mPaused) {
+        //Pause the timer
+        mPaused = true;
+
+        //Calculate the paused counter ticks
+        mPausedCounter = SDL_GetPerformanceCounter() - mStartCounter;
+        mStartCounter = 0;
+    }
+}
+
+inline void LHighResTimer::unpause() {
+    //If the timer is running and paused
+    if (mStarted && mPaused) {
+        //Unpause the timer
+        mPaused = false;
+
+        //Reset the starting counter
+        mStartCounter = SDL_GetPerformanceCounter() - mPausedCounter;
+
+        //Reset the paused counter ticks
+        mPausedCounter = 0;
+    }
+}
+
+//Gets the timer's time in nanoseconds
+inline Uint64 LHighResTimer::getTicks() const {
+    //The actual timer time in counter ticks
+    Uint64 counter = 0;
+
+    //If the timer is running
+    if (mStarted) {
+        //If the timer is paused
+        if (mPaused) {
+            //Return the number of ticks when the timer was paused
+            counter = mPausedCounter;
+        }
+        else {
+            //Return the current counter minus the start counter
+            counter = SDL_GetPerformanceCounter() - mStartCounter;
+        }
+    }
+    return toNanoseconds(counter);
+}
+
+//Checks the status of the timer
+inline bool LHighResTimer::isStarted() const {
+    //Timer is running and paused or unpaused
+    return mStarted;
+}
+
+inline bool LHighResTimer::isPaused() const {
+    //Timer is running and paused
+    return mPaused && mStarted;
+}
+
+//Converts performance counter ticks to nanoseconds
+inline Uint64 LHighResTimer::toNanoseconds(const Uint64 counter) {
+    static const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    //Split whole seconds off so the multiplication cannot overflow
+    return counter / frequency * NANOSECONDS_PER_SECOND + counter % frequency * NANOSECONDS_PER_SECOND / frequency;
+}
+
+/*-----*
+Objects
+-------*/
+
+//The frames per second timer
+extern LHighResTimer fpsTimer;
+
+#endif //LHIGHRESTIMER_H
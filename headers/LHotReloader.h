@@ -0,0 +1,263 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LHOTRELOADER_H
+#define LHOTRELOADER_H
+#include <SDL.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+#include "LHighResTimer.h"
+#include "LProfiler.h"
+
+//Watches loaded files and swaps in new versions at frame boundaries
+class LHotReloader {
+public:
+    //Initializes variables
+    LHotReloader();
+
+    //Deallocates memory
+    ~LHotReloader();
+
+    //Starts watching, fails where file notifications are unsupported
+    bool open();
+
+    //Watches a file, work runs on a worker when it changes and finish on the render thread once work succeeded,
+    //either may be empty, register every file before the first update
+    bool watch(const std::string& path, std::function<bool()> work, std::function<bool()> finish);
+
+    //Picks up changes and finishes reloads that are ready, call once per frame
+    void update();
+
+    //Waits for reloads in flight and stops watching
+    void close();
+
+    //Gets watching state
+    bool isOpen() const;
+
+private:
+    //What a worker hands back
+    struct Result {
+        bool success;
+        Uint64 workTime;
+    };
+
+    //A watched file
+    struct Watch {
+        std::string path;
+        std::string file;
+        int descriptor;
+        std::function<bool()> work;
+        std::function<bool()> finish;
+
+        //The reload in flight and whether the file changed again meanwhile
+        std::future<Result> job;
+        bool pending;
+        bool again;
+
+        //When the change was noticed, and when the first change during a reload was
+        Uint64 changedAt;
+        Uint64 changedAgainAt;
+    };
+
+    //Reads queued notifications and starts reloads
+    void readEvents();
+
+    //Starts reloading a file on a worker
+    void start(Watch& watch);
+
+    //Watched files
+    std::vector<Watch> mWatches;
+
+    //The notification instance
+    int mDescriptor;
+
+    //Time since watching started
+    LHighResTimer mClock;
+};
+
+/*---------------------*
+LHotReloader functions
+-----------------------*/
+
+//Initializes variables
+inline LHotReloader::LHotReloader() {
+    mDescriptor = -1;
+}
+
+//Deallocates memory
+inline LHotReloader::~LHotReloader() {
+    close();
+}
+
+//Starts watching
+inline bool LHotReloader::open() {
+    //Stop preexisting watches
+    close();
+
+#ifdef __linux__
+    //Never block the frame waiting for notifications
+    mDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (mDescriptor < 0) {
+        printf("Unable to start watching files!\n");
+        return false;
+    }
+    mClock.start();
+    return true;
+#else
+    printf("Hot reload is only supported on Linux!\n");
+    return false;
+#endif
+}
+
+//Watches a file
+inline bool LHotReloader::watch(const std::string& path, std::function<bool()> work, std::function<bool()> finish) {
+    if (mDescriptor < 0) {
+        return false;
+    }
+
+    //Watch the directory, editors often save by writing a new file and renaming it over the old one
+    const size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+    const std::string file = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    int descriptor = -1;
+#ifdef __linux__
+    descriptor = inotify_add_watch(mDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+#endif
+    if (descriptor < 0) {
+        printf("Unable to watch %s!\n", path.c_str());
+        return false;
+    }
+
+    mWatches.push_back({path, file, descriptor, std::move(work), std::move(finish), {}, false, false, 0, 0});
+    return true;
+}
+
+//Picks up changes and finishes reloads that are ready
+inline void LHotReloader::update() {
+    if (mDescriptor < 0) {
+        return;
+    }
+    PROFILE_ZONE("hot reload");
+
+    readEvents();
+
+    //Swap in whatever the workers are done with, the rest waits for a later frame
+    for (Watch& watch : mWatches) {
+        if (!watch.pending || watch.job.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            continue;
+        }
+
+        const Result result = watch.job.get();
+        bool success = result.success;
+        const Uint64 finishStart = mClock.getTicks();
+        if (success && watch.finish) {
+            PROFILE_ZONE("reload swap");
+            success = watch.finish();
+        }
+        const Uint64 finishTime = mClock.getTicks() - finishStart;
+        const Uint64 latency = mClock.getTicks() - watch.changedAt;
+
+        //Worker time and time since the change was noticed go into the profile alongside the swap
+        PROFILE_RECORD("reload work", result.workTime);
+        PROFILE_RECORD("reload latency", latency);
+        printf("Reloaded %s%s in %.2f ms: work %.2f ms, swap %.2f ms\n", watch.path.c_str(), success ? "" : " (failed)",
+            static_cast<double>(latency) / NANOSECONDS_PER_MILLISECOND,
+            static_cast<double>(result.workTime) / NANOSECONDS_PER_MILLISECOND,
+            static_cast<double>(finishTime) / NANOSECONDS_PER_MILLISECOND);
+
+        //Saved again while reloading, go once more
+        watch.pending = false;
+        if (watch.again) {
+            watch.again = false;
+            watch.changedAt = watch.changedAgainAt;
+            start(watch);
+        }
+    }
+}
+
+//Waits for reloads in flight and stops watching
+inline void LHotReloader::close() {
+    for (Watch& watch : mWatches) {
+        if (watch.pending) {
+            watch.job.wait();
+        }
+    }
+    mWatches.clear();
+
+#ifdef __linux__
+    if (mDescriptor >= 0) {
+        ::close(mDescriptor);
+    }
+#endif
+    mDescriptor = -1;
+}
+
+//Gets watching state
+inline bool LHotReloader::isOpen() const {
+    return mDescriptor >= 0;
+}
+
+//Reads queued notifications and starts reloads
+inline void LHotReloader::readEvents() {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(mDescriptor, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            if (event->len == 0) {
+                continue;
+            }
+
+            for (Watch& watch : mWatches) {
+                if (watch.descriptor != event->wd || watch.file != event->name) {
+                    continue;
+                }
+
+                //One reload at a time per file
+                if (watch.pending) {
+                    //Latency of the next reload counts from the first save it picks up
+                    if (!watch.again) {
+                        watch.changedAgainAt = mClock.getTicks();
+                    }
+                    watch.again = true;
+                }
+                else {
+                    watch.changedAt = mClock.getTicks();
+                    start(watch);
+                }
+            }
+        }
+    }
+#endif
+}
+
+//Starts reloading a file on a worker
+inline void LHotReloader::start(Watch& watch) {
+    watch.pending = true;
+    watch.job = std::async(std::launch::async, [work = watch.work] {
+        LHighResTimer timer;
+        timer.start();
+        const bool success = !work || work();
+        return Result{success, timer.getTicks()};
+    });
+}
+
+/*-----*
+Objects
+-------*/
+
+//Reloads edited assets while the game runs
+extern LHotReloader gHotReloader;
+
+#endif //LHOTRELOADER_H
@@ -0,0 +1,450 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LINPUTRECORDER_H
+#define LINPUTRECORDER_H
+#include <SDL.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//Replay file version, bumped whenever the layout changes
+inline constexpr Uint8 REPLAY_VERSION = 2;
+
+//Most ticks between records, idle stretches get a mark so a crashed recording still shows how far it got
+inline constexpr Uint64 REPLAY_MARK_TICKS = 30;
+
+//Kinds of records in a replay
+enum ReplayRecord {
+    RECORD_KEY_DOWN,
+    RECORD_KEY_UP,
+    RECORD_JOY_AXIS,
+    RECORD_WINDOW,
+    RECORD_MARK,
+    RECORD_END
+};
+
+//Captures the input consumed before each simulation tick, or feeds a capture back at the same ticks.
+//A replay is "LREC", the version and the tick rate, then records of ticks since the last record,
+//kind and payload, numbers written seven bits a byte so most records take four or five bytes.
+//A recording without an end record crashed at most REPLAY_MARK_TICKS after its last record, its replay runs that far
+class LInputRecorder {
+public:
+    //Initializes variables
+    LInputRecorder();
+
+    //Closes the file
+    ~LInputRecorder();
+
+    //Starts writing input to a file, ticks count from zero
+    bool startRecording(const std::string& path, int tickRate);
+
+    //Loads a recording to feed back, recorded window events go to the given window
+    bool startReplay(const std::string& path, int tickRate, Uint32 windowID);
+
+    //Writes an event if replays need it, tagged with the current tick
+    void record(const SDL_Event& event);
+
+    //Gets the next event recorded for the current tick, false once this tick has no more
+    bool nextEvent(SDL_Event& event);
+
+    //Moves on to the next tick, call after every simulation tick
+    void endTick();
+
+    //Ends a recording with its length and a state hash, or checks both at the end of a replay,
+    //false when the replay did not end where and how the recording did
+    bool stop(Uint64 stateHash);
+
+    //Gets recording and replay state
+    bool isRecording() const;
+    bool isReplaying() const;
+
+    //Checks if a replay is over, at its end record or past where a crashed recording stopped
+    bool isFinished() const;
+
+    //Gets ticks since starting
+    Uint64 getTick() const;
+
+private:
+    //Appends a number to the pending record, signed numbers are zigzagged so small negatives stay small
+    void writeNumber(Uint64 value);
+    void writeSigned(Sint64 value);
+
+    //Reads a number from the replay, false past its end
+    bool readNumber(Uint64& value);
+    bool readSigned(Sint64& value);
+    bool readByte(Uint8& value);
+
+    //Starts a record at the current tick
+    void beginRecord(ReplayRecord kind);
+
+    //Writes the pending record and flushes it, so a crash keeps every record before it
+    void flushRecord();
+
+    //Reads how many ticks away the next record is
+    void readNextTick();
+
+    //Recording file and the record being put together
+    FILE* mFile;
+    std::vector<Uint8> mPending;
+    Uint64 mLastRecordTick;
+
+    //Replay contents and the read position
+    std::vector<Uint8> mReplay;
+    size_t mReadOffset;
+
+    //Tick of the next record, or of the last one once the replay is used up
+    bool mHasNext;
+    Uint64 mNextTick;
+
+    //Where and how the recording ended, once reached
+    bool mEnded;
+    Uint64 mEndHash;
+
+    bool mRecording;
+    bool mReplaying;
+    Uint64 mTick;
+    Uint32 mWindowID;
+    std::string mPath;
+};
+
+/*-----------------------*
+LInputRecorder functions
+-------------------------*/
+
+//Initializes variables
+inline LInputRecorder::LInputRecorder() {
+    mFile = nullptr;
+    mLastRecordTick = 0;
+    mReadOffset = 0;
+    mHasNext = false;
+    mNextTick = 0;
+    mEnded = false;
+    mEndHash = 0;
+    mRecording = false;
+    mReplaying = false;
+    mTick = 0;
+    mWindowID = 0;
+}
+
+//Closes the file
+inline LInputRecorder::~LInputRecorder() {
+    if (mFile != nullptr) {
+        fclose(mFile);
+    }
+}
+
+//Starts writing input to a file
+inline bool LInputRecorder::startRecording(const std::string& path, const int tickRate) {
+    mFile = fopen(path.c_str(), "wb");
+    if (mFile == nullptr) {
+        printf("Unable to record input to %s!\n", path.c_str());
+        return false;
+    }
+
+    mPending = {'L', 'R', 'E', 'C', REPLAY_VERSION};
+    writeNumber(static_cast<Uint64>(tickRate));
+    flushRecord();
+
+    mRecording = true;
+    mTick = 0;
+    mLastRecordTick = 0;
+    mPath = path;
+    return true;
+}
+
+//Loads a recording to feed back
+inline bool LInputRecorder::startReplay(const std::string& path, const int tickRate, const Uint32 windowID) {
+    //Read the whole replay up front, they are small and the disk stays out of the timing
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        printf("Unable to open replay %s!\n", path.c_str());
+        return false;
+    }
+    mReplay.clear();
+    Uint8 buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        mReplay.insert(mReplay.end(), buffer, buffer + read);
+    }
+    fclose(file);
+
+    //Check the header
+    Uint64 recordedRate = 0;
+    mReadOffset = 5;
+    if (mReplay.size() < 5 || memcmp(mReplay.data(), "LREC", 4) != 0 || mReplay[4] != REPLAY_VERSION || !readNumber(recordedRate)) {
+        printf("%s is not a replay of this version!\n", path.c_str());
+        return false;
+    }
+    if (recordedRate != static_cast<Uint64>(tickRate)) {
+        printf("%s was recorded at %llu ticks per second, the game runs at %d!\n", path.c_str(), static_cast<unsigned long long>(recordedRate), tickRate);
+        return false;
+    }
+
+    mReplaying = true;
+    mTick = 0;
+    mNextTick = 0;
+    mEnded = false;
+    mWindowID = windowID;
+    mPath = path;
+    readNextTick();
+    return true;
+}
+
+//Writes an event if replays need it
+inline void LInputRecorder::record(const SDL_Event& event) {
+    if (!mRecording) {
+        return;
+    }
+
+    if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {
+        beginRecord(event.type == SDL_KEYDOWN ? RECORD_KEY_DOWN : RECORD_KEY_UP);
+        writeSigned(event.key.keysym.sym);
+        mPending.push_back(event.key.repeat);
+    }
+    else if (event.type == SDL_JOYAXISMOTION) {
+        beginRecord(RECORD_JOY_AXIS);
+        writeSigned(event.jaxis.which);
+        mPending.push_back(event.jaxis.axis);
+        writeSigned(event.jaxis.value);
+    }
+    else if (event.type == SDL_WINDOWEVENT && (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || event.window.event == SDL_WINDOWEVENT_RESIZED)) {
+        beginRecord(RECORD_WINDOW);
+        mPending.push_back(event.window.event);
+        writeSigned(event.window.data1);
+        writeSigned(event.window.data2);
+    }
+    else {
+        return;
+    }
+
+    flushRecord();
+}
+
+//Gets the next event recorded for the current tick
+inline bool LInputRecorder::nextEvent(SDL_Event& event) {
+    if (!mReplaying || !mHasNext || mNextTick != mTick) {
+        return false;
+    }
+
+    Uint8 kind;
+    if (!readByte(kind)) {
+        mHasNext = false;
+        return false;
+    }
+
+    memset(&event, 0, sizeof(event));
+    bool valid = true;
+    switch (kind) {
+        case RECORD_KEY_DOWN:
+        case RECORD_KEY_UP: {
+            //Keys go to the game, not to the window, so a replay never toggles full screen
+            Sint64 sym;
+            Uint8 repeat;
+            valid = readSigned(sym) && readByte(repeat);
+            event.type = kind == RECORD_KEY_DOWN ? SDL_KEYDOWN : SDL_KEYUP;
+            event.key.state = kind == RECORD_KEY_DOWN ? SDL_PRESSED : SDL_RELEASED;
+            event.key.repeat = repeat;
+            event.key.keysym.sym = static_cast<SDL_Keycode>(sym);
+            break;
+        }
+        case RECORD_JOY_AXIS: {
+            Sint64 which, value;
+            Uint8 axis;
+            valid = readSigned(which) && readByte(axis) && readSigned(value);
+            event.type = SDL_JOYAXISMOTION;
+            event.jaxis.which = static_cast<SDL_JoystickID>(which);
+            event.jaxis.axis = axis;
+            event.jaxis.value = static_cast<Sint16>(value);
+            break;
+        }
+        case RECORD_WINDOW: {
+            Uint8 windowEvent;
+            Sint64 data1, data2;
+            valid = readByte(windowEvent) && readSigned(data1) && readSigned(data2);
+            event.type = SDL_WINDOWEVENT;
+            event.window.windowID = mWindowID;
+            event.window.event = windowEvent;
+            event.window.data1 = static_cast<Sint32>(data1);
+            event.window.data2 = static_cast<Sint32>(data2);
+            break;
+        }
+        case RECORD_MARK:
+            //Only says the recording got this far, look at what comes after it
+            readNextTick();
+            return nextEvent(event);
+        case RECORD_END: {
+            //Eight bytes of state hash, the replay is over
+            mEndHash = 0;
+            for (int i = 0; i < 8 && valid; ++i) {
+                Uint8 byte;
+                valid = readByte(byte);
+                mEndHash |= static_cast<Uint64>(byte) << (8 * i);
+            }
+            mEnded = valid;
+            mHasNext = false;
+            return false;
+        }
+        default:
+            valid = false;
+            break;
+    }
+
+    if (!valid) {
+        printf("Replay %s is damaged past tick %llu!\n", mPath.c_str(), static_cast<unsigned long long>(mTick));
+        mHasNext = false;
+        return false;
+    }
+
+    readNextTick();
+    return true;
+}
+
+//Moves on to the next tick
+inline void LInputRecorder::endTick() {
+    ++mTick;
+
+    //Mark idle stretches, a crash leaves at most REPLAY_MARK_TICKS unaccounted for
+    if (mRecording && mTick - mLastRecordTick >= REPLAY_MARK_TICKS) {
+        beginRecord(RECORD_MARK);
+        flushRecord();
+    }
+}
+
+//Ends a recording, or checks the end of a replay
+inline bool LInputRecorder::stop(const Uint64 stateHash) {
+    bool success = true;
+    if (mRecording) {
+        beginRecord(RECORD_END);
+        for (int i = 0; i < 8; ++i) {
+            mPending.push_back(static_cast<Uint8>(stateHash >> (8 * i)));
+        }
+        flushRecord();
+        fclose(mFile);
+        mFile = nullptr;
+        printf("Recorded %llu ticks to %s, state hash %016llx\n", static_cast<unsigned long long>(mTick), mPath.c_str(), static_cast<unsigned long long>(stateHash));
+    }
+    else if (mReplaying) {
+        if (!mEnded) {
+            printf("Replay %s has no end, ran %llu ticks to past where its recording stopped\n", mPath.c_str(), static_cast<unsigned long long>(mTick));
+        }
+        else if (stateHash != mEndHash) {
+            printf("Replay %s diverged: state hash %016llx, recorded %016llx\n", mPath.c_str(), static_cast<unsigned long long>(stateHash), static_cast<unsigned long long>(mEndHash));
+            success = false;
+        }
+        else {
+            printf("Replay %s matches after %llu ticks, state hash %016llx\n", mPath.c_str(), static_cast<unsigned long long>(mTick), static_cast<unsigned long long>(stateHash));
+        }
+    }
+
+    mRecording = false;
+    mReplaying = false;
+    return success;
+}
+
+//Gets recording state
+inline bool LInputRecorder::isRecording() const {
+    return mRecording;
+}
+
+//Gets replay state
+inline bool LInputRecorder::isReplaying() const {
+    return mReplaying;
+}
+
+//Checks if a replay is over
+inline bool LInputRecorder::isFinished() const {
+    //Without an end record the recording stopped before the mark that would have followed its last record
+    return mReplaying && !mHasNext && (mEnded || mTick >= mNextTick + REPLAY_MARK_TICKS);
+}
+
+//Gets ticks since starting
+inline Uint64 LInputRecorder::getTick() const {
+    return mTick;
+}
+
+//Appends a number to the pending record
+inline void LInputRecorder::writeNumber(Uint64 value) {
+    while (value >= 0x80) {
+        mPending.push_back(static_cast<Uint8>(value | 0x80));
+        value >>= 7;
+    }
+    mPending.push_back(static_cast<Uint8>(value));
+}
+
+//Appends a signed number to the pending record
+inline void LInputRecorder::writeSigned(const Sint64 value) {
+    writeNumber((static_cast<Uint64>(value) << 1) ^ static_cast<Uint64>(value >> 63));
+}
+
+//Reads a number from the replay
+inline bool LInputRecorder::readNumber(Uint64& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        Uint8 byte;
+        if (!readByte(byte)) {
+            return false;
+        }
+        value |= static_cast<Uint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Reads a signed number from the replay
+inline bool LInputRecorder::readSigned(Sint64& value) {
+    Uint64 zigzag;
+    if (!readNumber(zigzag)) {
+        return false;
+    }
+    value = static_cast<Sint64>(zigzag >> 1) ^ -static_cast<Sint64>(zigzag & 1);
+    return true;
+}
+
+//Reads a byte from the replay
+inline bool LInputRecorder::readByte(Uint8& value) {
+    if (mReadOffset >= mReplay.size()) {
+        return false;
+    }
+    value = mReplay[mReadOffset++];
+    return true;
+}
+
+//Starts a record, with the ticks since the last one first, usually a single byte
+inline void LInputRecorder::beginRecord(const ReplayRecord kind) {
+    writeNumber(mTick - mLastRecordTick);
+    mPending.push_back(static_cast<Uint8>(kind));
+    mLastRecordTick = mTick;
+}
+
+//Writes the pending record and flushes it
+inline void LInputRecorder::flushRecord() {
+    if (mFile != nullptr && !mPending.empty()) {
+        fwrite(mPending.data(), 1, mPending.size(), mFile);
+        fflush(mFile);
+    }
+    mPending.clear();
+}
+
+//Reads how many ticks away the next record is
+inline void LInputRecorder::readNextTick() {
+    //The last record's tick stays when there are no more, crashed recordings end near it
+    Uint64 delta;
+    mHasNext = readNumber(delta);
+    if (mHasNext) {
+        mNextTick += delta;
+    }
+}
+
+/*-----*
+Objects
+-------*/
+
+//Records or replays the input driving the simulation
+extern LInputRecorder gInputRecorder;
+
+#endif //LINPUTRECORDER_H
@@ -0,0 +1,416 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LJOBSYSTEM_H
+#define LJOBSYSTEM_H
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//Job slots, reused round robin so a slot must be finished MAX_JOBS jobs later
+inline constexpr int MAX_JOBS = 4096;
+
+//Most pieces one job is split into, larger ranges get a coarser grain so a job's pieces,
+//about twice this many slots with the halves they came from, leave the ring room for the jobs queued behind it
+inline constexpr int MAX_JOB_PIECES = MAX_JOBS / 16;
+
+//Most worker threads started
+inline constexpr int MAX_JOB_WORKERS = 64;
+
+//Bytes a job body may capture, bodies are copied into the job
+inline constexpr int JOB_BODY_SIZE = 64;
+
+//Jobs that may wait on one job, more are waited for on the spot
+inline constexpr int MAX_JOB_CONTINUATIONS = 16;
+
+//A range of work, split in halves until a piece is no larger than the grain
+struct LJob {
+    //Runs the body over [begin, end)
+    void (*function)(const void* body, int begin, int end);
+    alignas(16) unsigned char body[JOB_BODY_SIZE];
+    int begin;
+    int end;
+    int grain;
+
+    //Job finishing along with this one, for split pieces
+    LJob* parent;
+
+    //This job plus its unfinished pieces
+    std::atomic<int> unfinished;
+
+    //Dependencies left, plus one while the job is being set up
+    std::atomic<int> waiting;
+
+    //Jobs started once this one finished, guarded by the mutex along with done
+    std::mutex mutex;
+    LJob* continuations[MAX_JOB_CONTINUATIONS];
+    int continuationCount;
+    std::atomic<bool> done;
+};
+
+//Work-stealing thread pool, every thread pushes and pops its own queue and steals from the others when empty
+class LJobSystem {
+public:
+    //Initializes variables
+    LJobSystem();
+
+    //Stops the workers
+    ~LJobSystem();
+
+    //Starts workers, a negative count leaves one core for the calling thread
+    void start(int workers = -1);
+
+    //Finishes queued jobs and stops the workers
+    void stop();
+
+    //Runs body(begin, end) over pieces of [0, count) once every dependency finished
+    template<typename F>
+    LJob* parallelFor(int count, int grain, const F& body, std::initializer_list<LJob*> dependencies = {});
+
+    //Runs jobs until the given one finished
+    void wait(LJob* job);
+
+    //Gets number of worker threads, the calling thread helps on top of these
+    int getWorkerCount() const;
+
+private:
+    //A thread's jobs, the owner works at the back and thieves take from the front
+    struct WorkQueue {
+        std::mutex mutex;
+        LJob* jobs[MAX_JOBS];
+        unsigned head;
+        unsigned tail;
+    };
+
+    //Takes a job slot and sets it up, the job starts once its dependencies finished
+    LJob* create(void (*function)(const void*, int, int), const void* body, size_t bodySize, int count, int grain, std::initializer_list<LJob*> dependencies);
+
+    //Takes the next slot from the ring
+    LJob* allocate();
+
+    //Drops one dependency of a job, queueing it once none are left
+    void release(LJob* job);
+
+    //Queues a job on the calling thread's queue
+    void push(LJob* job);
+
+    //Finds a job, own queue first
+    LJob* find(int queue);
+
+    //Hands out a job just removed from a locked queue, rewinding its counters once empty
+    static LJob* take(WorkQueue& queue, LJob* job);
+
+    //Runs or splits a job
+    void execute(LJob* job);
+
+    //Marks a piece done, finishing its parent and starting continuations once everything is
+    void finish(LJob* job);
+
+    //Runs jobs until told to quit
+    void workerLoop(int queue);
+
+    //Queue of the calling thread, threads that are not workers share the first
+    static int& currentQueue();
+
+    //Job slots and the next one to hand out
+    std::unique_ptr<LJob[]> mJobs;
+    std::atomic<unsigned> mNextJob;
+
+    //One queue for outside threads and one per worker
+    std::vector<std::unique_ptr<WorkQueue>> mQueues;
+    std::vector<std::thread> mWorkers;
+
+    //Bumped on every push so sleeping workers wake up
+    std::atomic<int> mSignal;
+    std::atomic<bool> mQuit;
+};
+
+/*-------------------*
+LJobSystem functions
+---------------------*/
+
+//Initializes variables
+inline LJobSystem::LJobSystem() {
+    mNextJob = 0;
+    mSignal = 0;
+    mQuit = false;
+}
+
+//Stops the workers
+inline LJobSystem::~LJobSystem() {
+    stop();
+}
+
+//Starts workers
+inline void LJobSystem::start(int workers) {
+    //Stop preexisting workers
+    stop();
+
+    if (workers < 0) {
+        workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+    workers = std::clamp(workers, 0, MAX_JOB_WORKERS);
+
+    //Slots and queues are allocated once here, never while running
+    if (mJobs == nullptr) {
+        mJobs = std::make_unique<LJob[]>(MAX_JOBS);
+    }
+    mQueues.clear();
+    for (int i = 0; i <= workers; ++i) {
+        mQueues.push_back(std::make_unique<WorkQueue>());
+        mQueues.back()->head = 0;
+        mQueues.back()->tail = 0;
+    }
+
+    mQuit = false;
+    for (int i = 1; i <= workers; ++i) {
+        mWorkers.emplace_back(&LJobSystem::workerLoop, this, i);
+    }
+}
+
+//Finishes queued jobs and stops the workers
+inline void LJobSystem::stop() {
+    //Outstanding jobs run on the calling thread
+    if (!mQueues.empty()) {
+        while (LJob* job = find(0)) {
+            execute(job);
+        }
+    }
+
+    mQuit = true;
+    ++mSignal;
+    mSignal.notify_all();
+    for (std::thread& worker : mWorkers) {
+        worker.join();
+    }
+    mWorkers.clear();
+}
+
+//Runs body over pieces of [0, count)
+template<typename F>
+LJob* LJobSystem::parallelFor(const int count, const int grain, const F& body, const std::initializer_list<LJob*> dependencies) {
+    //Bodies are copied byte for byte and never destroyed, so capture pointers and values only
+    static_assert(sizeof(F) <= JOB_BODY_SIZE && alignof(F) <= 16, "Job body captures too much");
+    static_assert(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>, "Job body must be trivially copyable");
+
+    return create([](const void* stored, const int begin, const int end) {
+        (*static_cast<const F*>(stored))(begin, end);
+    }, &body, sizeof(F), count, grain, dependencies);
+}
+
+//Runs jobs until the given one finished
+inline void LJobSystem::wait(LJob* job) {
+    const int queue = currentQueue();
+    while (!job->done.load(std::memory_order_acquire)) {
+        //Help out rather than sleep
+        if (LJob* next = find(queue)) {
+            execute(next);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//Gets number of worker threads
+inline int LJobSystem::getWorkerCount() const {
+    return static_cast<int>(mWorkers.size());
+}
+
+//Takes a job slot and sets it up
+inline LJob* LJobSystem::create(void (*function)(const void*, int, int), const void* body, const size_t bodySize, const int count, const int grain, const std::initializer_list<LJob*> dependencies) {
+    LJob* job = allocate();
+    job->function = function;
+    memcpy(job->body, body, bodySize);
+    job->begin = 0;
+    job->end = std::max(0, count);
+    job->grain = std::max({1, grain, (job->end + MAX_JOB_PIECES - 1) / MAX_JOB_PIECES});
+    job->parent = nullptr;
+    job->unfinished = 1;
+    job->waiting = static_cast<int>(dependencies.size()) + 1;
+
+    //Ask every dependency to start this job when it is done
+    for (LJob* dependency : dependencies) {
+        bool registered = false;
+        {
+            std::lock_guard lock(dependency->mutex);
+            if (!dependency->done && dependency->continuationCount < MAX_JOB_CONTINUATIONS) {
+                dependency->continuations[dependency->continuationCount++] = job;
+                registered = true;
+            }
+        }
+
+        //Finished already, or too many waiting on it
+        if (!registered) {
+            wait(dependency);
+            --job->waiting;
+        }
+    }
+
+    //Setup is over
+    release(job);
+    return job;
+}
+
+//Takes the next slot from the ring
+inline LJob* LJobSystem::allocate() {
+    LJob* job = &mJobs[mNextJob.fetch_add(1, std::memory_order_relaxed) % MAX_JOBS];
+
+    //The ring came round to a job still running, carrying on would corrupt it and whatever waits on it
+    if (job->unfinished.load(std::memory_order_acquire) != 0) {
+        printf("Job system ran out of slots, more than %d jobs in flight!\n", MAX_JOBS);
+        std::abort();
+    }
+
+    std::lock_guard lock(job->mutex);
+    job->continuationCount = 0;
+    job->done = false;
+    return job;
+}
+
+//Drops one dependency of a job
+inline void LJobSystem::release(LJob* job) {
+    if (job->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        push(job);
+    }
+}
+
+//Queues a job on the calling thread's queue
+inline void LJobSystem::push(LJob* job) {
+    WorkQueue& queue = *mQueues[currentQueue()];
+    {
+        std::lock_guard lock(queue.mutex);
+        assert(queue.tail - queue.head < MAX_JOBS && "Job queue is full");
+        queue.jobs[queue.tail++ % MAX_JOBS] = job;
+    }
+
+    //Wake a sleeping worker
+    ++mSignal;
+    mSignal.notify_one();
+}
+
+//Finds a job, own queue first
+inline LJob* LJobSystem::find(const int queue) {
+    //Newest own job first, its data is likely still in cache
+    {
+        WorkQueue& own = *mQueues[queue];
+        std::lock_guard lock(own.mutex);
+        if (own.tail != own.head) {
+            return take(own, own.jobs[--own.tail % MAX_JOBS]);
+        }
+    }
+
+    //Oldest job of another queue, usually the biggest piece left
+    const int queues = static_cast<int>(mQueues.size());
+    for (int i = 1; i < queues; ++i) {
+        WorkQueue& victim = *mQueues[(queue + i) % queues];
+        std::lock_guard lock(victim.mutex);
+        if (victim.tail != victim.head) {
+            return take(victim, victim.jobs[victim.head++ % MAX_JOBS]);
+        }
+    }
+
+    return nullptr;
+}
+
+//Hands out a job just removed from a queue
+inline LJob* LJobSystem::take(WorkQueue& queue, LJob* job) {
+    //Counters restart whenever the queue empties, so steals never run them up to wrapping
+    if (queue.head == queue.tail) {
+        queue.head = 0;
+        queue.tail = 0;
+    }
+    return job;
+}
+
+//Runs or splits a job
+inline void LJobSystem::execute(LJob* job) {
+    if (job->end - job->begin > job->grain) {
+        //Split in halves and queue both, idle threads steal the larger pieces
+        const int middle = job->begin + (job->end - job->begin) / 2;
+        job->unfinished.fetch_add(2, std::memory_order_relaxed);
+        for (const int half : {0, 1}) {
+            LJob* piece = allocate();
+            piece->function = job->function;
+            memcpy(piece->body, job->body, JOB_BODY_SIZE);
+            piece->begin = half == 0 ? job->begin : middle;
+            piece->end = half == 0 ? middle : job->end;
+            piece->grain = job->grain;
+            piece->parent = job;
+            piece->unfinished = 1;
+            piece->waiting = 0;
+            push(piece);
+        }
+    }
+    else if (job->end > job->begin) {
+        job->function(job->body, job->begin, job->end);
+    }
+
+    finish(job);
+}
+
+//Marks a piece done
+inline void LJobSystem::finish(LJob* job) {
+    if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    //Take the continuations and mark done in one step so no new ones slip in
+    LJob* continuations[MAX_JOB_CONTINUATIONS];
+    int continuationCount;
+    {
+        std::lock_guard lock(job->mutex);
+        continuationCount = job->continuationCount;
+        std::copy(job->continuations, job->continuations + continuationCount, continuations);
+        job->done.store(true, std::memory_order_release);
+    }
+
+    for (int i = 0; i < continuationCount; ++i) {
+        release(continuations[i]);
+    }
+    if (job->parent != nullptr) {
+        finish(job->parent);
+    }
+}
+
+//Runs jobs until told to quit
+inline void LJobSystem::workerLoop(const int queue) {
+    currentQueue() = queue;
+    while (true) {
+        //Read the signal first so a push after the search still wakes us
+        const int signal = mSignal.load(std::memory_order_acquire);
+        if (LJob* job = find(queue)) {
+            execute(job);
+            continue;
+        }
+        if (mQuit) {
+            return;
+        }
+        mSignal.wait(signal, std::memory_order_acquire);
+    }
+}
+
+//Queue of the calling thread
+inline int& LJobSystem::currentQueue() {
+    thread_local int queue = 0;
+    return queue;
+}
+
+/*-----*
+Objects
+-------*/
+
+//Runs simulation systems across every core
+extern LJobSystem gJobSystem;
+
+#endif //LJOBSYSTEM_H
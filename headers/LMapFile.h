@@ -0,0 +1,443 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LMAPFILE_H
+#define LMAPFILE_H
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*----------------------------------------------------------------*
+Binary tile map layout, all fields little endian
+
+  MapFileHeader
+  MapChunkEntry[layerCount * chunkColumns * chunkRows]
+  chunk payloads
+
+Every chunk covers chunkSize x chunkSize tiles stored row by row,
+tiles past the map edge are zero. Raw payloads are read in place
+from the mapping, RLE payloads are (uint16 run, tile id) pairs.
+------------------------------------------------------------------*/
+
+//File identification
+inline constexpr char MAP_FILE_MAGIC[4] = {'L', 'M', 'A', 'P'};
+inline constexpr uint16_t MAP_FILE_VERSION = 1;
+
+//Widest chunk in tiles, bigger chunk sizes only come from corrupt headers
+inline constexpr int MAP_MAX_CHUNK_SIZE = 256;
+
+//Chunk payload encodings
+enum MapChunkEncoding : uint16_t {
+    MAP_CHUNK_RAW,
+    MAP_CHUNK_RLE
+};
+
+#pragma pack(push, 1)
+//Fixed size file header
+struct MapFileHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t bytesPerTile;
+    uint32_t width;
+    uint32_t height;
+    uint16_t tileWidth;
+    uint16_t tileHeight;
+    uint16_t layerCount;
+    uint16_t chunkSize;
+    uint32_t reserved[2];
+};
+
+//Where a chunk's payload lives
+struct MapChunkEntry {
+    uint64_t offset;
+    uint32_t size;
+    uint16_t encoding;
+    uint16_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(MapFileHeader) == 32, "Map file header must stay 32 bytes");
+static_assert(sizeof(MapChunkEntry) == 16, "Map chunk entry must stay 16 bytes");
+
+//Read only view of a binary map, memory mapped where supported
+class LMapFile {
+public:
+    //Initializes variables
+    LMapFile();
+
+    //Unmaps the file
+    ~LMapFile();
+
+    //A mapping cannot be shared
+    LMapFile(const LMapFile&) = delete;
+    LMapFile& operator=(const LMapFile&) = delete;
+
+    //Maps the file and validates its header and chunk table
+    bool open(const std::string& path);
+
+    //Unmaps the file
+    void close();
+
+    //Gets map properties
+    int getWidth() const;
+    int getHeight() const;
+    int getTileWidth() const;
+    int getTileHeight() const;
+    int getLayerCount() const;
+    int getChunkSize() const;
+    int getChunkColumns() const;
+    int getChunkRows() const;
+    int getBytesPerTile() const;
+
+    //Gets a chunk's table entry
+    const MapChunkEntry& getChunkEntry(int layer, int chunk) const;
+
+    //Gets a raw chunk's tiles in place, nullptr for encoded chunks
+    const uint8_t* getRawChunk(int layer, int chunk) const;
+
+    //Decodes a chunk's chunkSize * chunkSize tile ids
+    bool readChunk(int layer, int chunk, uint16_t* tiles) const;
+
+    //Gets one tile id, decoding its chunk if needed
+    int getTile(int layer, int x, int y) const;
+
+private:
+    //The mapped bytes
+    const uint8_t* mData;
+    size_t mSize;
+
+    //Copy of the file where mapping is unavailable
+    std::vector<uint8_t> mBuffer;
+
+    //Parsed views into the data
+    const MapFileHeader* mHeader;
+    const MapChunkEntry* mChunks;
+};
+
+//Writes tile layers as a binary map, layers hold width * height ids row by row
+bool writeMapFile(const std::string& path, int width, int height, int tileWidth, int tileHeight, const std::vector<std::vector<uint16_t>>& layers, int chunkSize, bool compress);
+
+/*----------------*
+LMapFile functions
+------------------*/
+
+//Initializes variables
+inline LMapFile::LMapFile() {
+    mData = nullptr;
+    mSize = 0;
+    mHeader = nullptr;
+    mChunks = nullptr;
+}
+
+//Unmaps the file
+inline LMapFile::~LMapFile() {
+    close();
+}
+
+//Maps the file and validates its header and chunk table
+inline bool LMapFile::open(const std::string& path) {
+    //Get rid of preexisting mapping
+    close();
+
+#ifdef _WIN32
+    //Read the whole file instead
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (file.fail()) {
+        printf("Unable to open map file %s!\n", path.c_str());
+        return false;
+    }
+    mBuffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(mBuffer.data()), static_cast<std::streamsize>(mBuffer.size()));
+    mData = mBuffer.data();
+    mSize = mBuffer.size();
+#else
+    //Map the file read only
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        printf("Unable to open map file %s!\n", path.c_str());
+        return false;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+        void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping != MAP_FAILED) {
+            mData = static_cast<const uint8_t*>(mapping);
+            mSize = static_cast<size_t>(status.st_size);
+        }
+    }
+    ::close(descriptor);
+    if (mData == nullptr) {
+        printf("Unable to map map file %s!\n", path.c_str());
+        return false;
+    }
+#endif
+
+    //Check the header
+    mHeader = reinterpret_cast<const MapFileHeader*>(mData);
+    if (mSize < sizeof(MapFileHeader) || memcmp(mHeader->magic, MAP_FILE_MAGIC, 4) != 0 || mHeader->version != MAP_FILE_VERSION) {
+        printf("%s is not a version %d map file!\n", path.c_str(), MAP_FILE_VERSION);
+        close();
+        return false;
+    }
+    if ((mHeader->bytesPerTile != 1 && mHeader->bytesPerTile != 2) || mHeader->chunkSize == 0 || mHeader->chunkSize > MAP_MAX_CHUNK_SIZE || mHeader->layerCount == 0 || mHeader->width == 0 || mHeader->height == 0) {
+        printf("Map file %s has an invalid header!\n", path.c_str());
+        close();
+        return false;
+    }
+
+    //Check the chunk table fits and every payload lies inside the file
+    const size_t totalChunks = static_cast<size_t>(getLayerCount()) * getChunkColumns() * getChunkRows();
+    if (mSize < sizeof(MapFileHeader) + totalChunks * sizeof(MapChunkEntry)) {
+        printf("Map file %s is truncated!\n", path.c_str());
+        close();
+        return false;
+    }
+    mChunks = reinterpret_cast<const MapChunkEntry*>(mData + sizeof(MapFileHeader));
+    const size_t rawSize = static_cast<size_t>(getChunkSize()) * getChunkSize() * mHeader->bytesPerTile;
+    for (size_t i = 0; i < totalChunks; ++i) {
+        const MapChunkEntry& entry = mChunks[i];
+        const bool badEncoding = entry.encoding == MAP_CHUNK_RAW ? entry.size != rawSize : entry.encoding != MAP_CHUNK_RLE;
+        if (badEncoding || entry.offset > mSize || entry.size > mSize - entry.offset) {
+            printf("Map file %s has a corrupt chunk table!\n", path.c_str());
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//Unmaps the file
+inline void LMapFile::close() {
+#ifndef _WIN32
+    if (mData != nullptr && mBuffer.empty()) {
+        munmap(const_cast<uint8_t*>(mData), mSize);
+    }
+#endif
+    mBuffer.clear();
+    mData = nullptr;
+    mSize = 0;
+    mHeader = nullptr;
+    mChunks = nullptr;
+}
+
+//Gets map properties
+inline int LMapFile::getWidth() const {
+    return static_cast<int>(mHeader->width);
+}
+
+inline int LMapFile::getHeight() const {
+    return static_cast<int>(mHeader->height);
+}
+
+inline int LMapFile::getTileWidth() const {
+    return mHeader->tileWidth;
+}
+
+inline int LMapFile::getTileHeight() const {
+    return mHeader->tileHeight;
+}
+
+inline int LMapFile::getLayerCount() const {
+    return mHeader->layerCount;
+}
+
+inline int LMapFile::getChunkSize() const {
+    return mHeader->chunkSize;
+}
+
+inline int LMapFile::getChunkColumns() const {
+    return (getWidth() + getChunkSize() - 1) / getChunkSize();
+}
+
+inline int LMapFile::getChunkRows() const {
+    return (getHeight() + getChunkSize() - 1) / getChunkSize();
+}
+
+inline int LMapFile::getBytesPerTile() const {
+    return mHeader->bytesPerTile;
+}
+
+//Gets a chunk's table entry
+inline const MapChunkEntry& LMapFile::getChunkEntry(const int layer, const int chunk) const {
+    return mChunks[static_cast<size_t>(layer) * getChunkColumns() * getChunkRows() + chunk];
+}
+
+//Gets a raw chunk's tiles in place, nullptr for encoded chunks
+inline const uint8_t* LMapFile::getRawChunk(const int layer, const int chunk) const {
+    const MapChunkEntry& entry = getChunkEntry(layer, chunk);
+    return entry.encoding == MAP_CHUNK_RAW ? mData + entry.offset : nullptr;
+}
+
+//Decodes a chunk's chunkSize * chunkSize tile ids
+inline bool LMapFile::readChunk(const int layer, const int chunk, uint16_t* tiles) const {
+    const MapChunkEntry& entry = getChunkEntry(layer, chunk);
+    const uint8_t* payload = mData + entry.offset;
+    const int bytesPerTile = mHeader->bytesPerTile;
+    const size_t totalTiles = static_cast<size_t>(getChunkSize()) * getChunkSize();
+
+    //Raw chunks are a straight copy
+    if (entry.encoding == MAP_CHUNK_RAW) {
+        for (size_t i = 0; i < totalTiles; ++i) {
+            tiles[i] = bytesPerTile == 1 ? payload[i] : static_cast<uint16_t>(payload[2 * i] | payload[2 * i + 1] << 8);
+        }
+        return true;
+    }
+
+    //Expand runs
+    const int runSize = 2 + bytesPerTile;
+    size_t written = 0;
+    for (uint32_t read = 0; read + runSize <= entry.size; read += runSize) {
+        const size_t run = payload[read] | payload[read + 1] << 8;
+        const uint16_t tile = bytesPerTile == 1 ? payload[read + 2] : static_cast<uint16_t>(payload[read + 2] | payload[read + 3] << 8);
+        if (written + run > totalTiles) {
+            return false;
+        }
+        for (size_t i = 0; i < run; ++i) {
+            tiles[written++] = tile;
+        }
+    }
+    return written == totalTiles;
+}
+
+//Gets one tile id, decoding its chunk if needed
+inline int LMapFile::getTile(const int layer, const int x, const int y) const {
+    const int chunkSize = getChunkSize();
+    const int chunk = y / chunkSize * getChunkColumns() + x / chunkSize;
+    const int index = y % chunkSize * chunkSize + x % chunkSize;
+
+    //Read in place
+    if (const uint8_t* raw = getRawChunk(layer, chunk)) {
+        return mHeader->bytesPerTile == 1 ? raw[index] : raw[2 * index] | raw[2 * index + 1] << 8;
+    }
+
+    //Decode the whole chunk
+    std::vector<uint16_t> tiles(static_cast<size_t>(chunkSize) * chunkSize);
+    return readChunk(layer, chunk, tiles.data()) ? tiles[index] : -1;
+}
+
+/*---------------*
+Map file writing
+-----------------*/
+
+//Writes tile layers as a binary map, layers hold width * height ids row by row
+inline bool writeMapFile(const std::string& path, const int width, const int height, const int tileWidth, const int tileHeight, const std::vector<std::vector<uint16_t>>& layers, const int chunkSize, const bool compress) {
+    //Narrowest tile id that fits every tile
+    uint16_t largestTile = 0;
+    for (const std::vector<uint16_t>& layer : layers) {
+        for (const uint16_t tile : layer) {
+            largestTile = tile > largestTile ? tile : largestTile;
+        }
+    }
+    const int bytesPerTile = largestTile < 256 ? 1 : 2;
+
+    //Header
+    MapFileHeader header = {};
+    memcpy(header.magic, MAP_FILE_MAGIC, 4);
+    header.version = MAP_FILE_VERSION;
+    header.bytesPerTile = static_cast<uint16_t>(bytesPerTile);
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.tileWidth = static_cast<uint16_t>(tileWidth);
+    header.tileHeight = static_cast<uint16_t>(tileHeight);
+    header.layerCount = static_cast<uint16_t>(layers.size());
+    header.chunkSize = static_cast<uint16_t>(chunkSize);
+
+    //Encode every chunk
+    const int chunkColumns = (width + chunkSize - 1) / chunkSize;
+    const int chunkRows = (height + chunkSize - 1) / chunkSize;
+    std::vector<MapChunkEntry> entries;
+    std::vector<uint8_t> payloads;
+    std::vector<uint16_t> chunkTiles(static_cast<size_t>(chunkSize) * chunkSize);
+    uint64_t offset = sizeof(MapFileHeader) + sizeof(MapChunkEntry) * layers.size() * chunkColumns * chunkRows;
+    for (const std::vector<uint16_t>& layer : layers) {
+        for (int chunk = 0; chunk < chunkColumns * chunkRows; ++chunk) {
+            //Gather the chunk's tiles, zero past the map edge
+            const int originX = chunk % chunkColumns * chunkSize;
+            const int originY = chunk / chunkColumns * chunkSize;
+            for (int y = 0; y < chunkSize; ++y) {
+                for (int x = 0; x < chunkSize; ++x) {
+                    const bool inside = originX + x < width && originY + y < height;
+                    chunkTiles[y * chunkSize + x] = inside ? layer[static_cast<size_t>(originY + y) * width + originX + x] : 0;
+                }
+            }
+
+            //Raw tiles
+            std::vector<uint8_t> raw;
+            for (const uint16_t tile : chunkTiles) {
+                raw.push_back(static_cast<uint8_t>(tile & 0xFF));
+                if (bytesPerTile == 2) {
+                    raw.push_back(static_cast<uint8_t>(tile >> 8));
+                }
+            }
+
+            //Runs of equal tiles
+            std::vector<uint8_t> runs;
+            if (compress) {
+                for (size_t i = 0; i < chunkTiles.size();) {
+                    size_t run = 1;
+                    while (i + run < chunkTiles.size() && chunkTiles[i + run] == chunkTiles[i] && run < 0xFFFF) {
+                        ++run;
+                    }
+                    runs.push_back(static_cast<uint8_t>(run & 0xFF));
+                    runs.push_back(static_cast<uint8_t>(run >> 8));
+                    runs.push_back(static_cast<uint8_t>(chunkTiles[i] & 0xFF));
+                    if (bytesPerTile == 2) {
+                        runs.push_back(static_cast<uint8_t>(chunkTiles[i] >> 8));
+                    }
+                    i += run;
+                }
+            }
+
+            //Keep whichever is smaller
+            const bool useRuns = compress && runs.size() < raw.size();
+            const std::vector<uint8_t>& payload = useRuns ? runs : raw;
+            entries.push_back({offset, static_cast<uint32_t>(payload.size()), static_cast<uint16_t>(useRuns ? MAP_CHUNK_RLE : MAP_CHUNK_RAW), 0});
+            payloads.insert(payloads.end(), payload.begin(), payload.end());
+            offset += payload.size();
+        }
+    }
+
+    //Write it all out next to the target, then swap it in so readers mapping the old file keep valid pages
+    const std::string tempPath = path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        printf("Unable to open %s for writing!\n", tempPath.c_str());
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    written = written && fwrite(entries.data(), sizeof(MapChunkEntry), entries.size(), file) == entries.size();
+    written = written && fwrite(payloads.data(), 1, payloads.size(), file) == payloads.size();
+    written = fclose(file) == 0 && written;
+
+    if (!written) {
+        printf("Unable to write map file %s!\n", tempPath.c_str());
+        remove(tempPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    //Windows will not rename over an existing file
+    remove(path.c_str());
+#endif
+    if (rename(tempPath.c_str(), path.c_str()) != 0) {
+        printf("Unable to replace map file %s!\n", path.c_str());
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+#endif //LMAPFILE_H
@@ -4,59 +4,170 @@
 
 #ifndef LPARTICLE_H
 #define LPARTICLE_H
-#include "LTexture.h"
+#include <vector>
+#include <SDL.h>
+#include "LTextureAtlas.h"
+#include "LSpriteBatch.h"
 
-//Particle engine
-class Particle {
+//Total particle slots shared by every emitter
+inline constexpr int MAX_PARTICLES = 32768;
+
+//Particle engine, fixed capacity storage recycled in place, emitters may be updated from different threads
+class LParticlePool {
 public:
-    //Initialize position and animation
-    Particle(int x, int y, int duration);
+    //Allocates every slot up front
+    explicit LParticlePool(int capacity);
+
+    //Reserves a range of slots for one emitter, returns first slot or -1 when full
+    int addEmitter(int count);
+
+    //Respawns the dead particles of an emitter around given point
+    void emit(int first, int count, int x, int y, int duration, const LTextureRegion* texture);
 
-    //Shows the particle
-    void render(SDL_Renderer *mRenderer, int camX, int camY);
+    //Animates the particles of an emitter
+    void update(int first, int count);
+
+    //Shows the particles of an emitter
+    void render(SDL_Renderer* mRenderer, int first, int count, int camX, int camY) const;
 
     //Checks if particle is dead
-    bool isDead();
+    bool isDead(int slot) const;
+
+    //Gets pool usage
+    int getCapacity() const;
+    int getUsed() const;
 
 private:
     //Offsets
-    int mPosX, mPosY;
+    std::vector<int> mPosX, mPosY;
 
     //Current frame of animation
-    int mFrame;
+    std::vector<int> mFrame;
 
     //Animation duration
-    int mDuration;
+    std::vector<int> mDuration;
 
     //Type of particle
-    LTexture* mTexture;
+    std::vector<const LTextureRegion*> mTexture;
+
+    //Random state of every slot, so emitters never share one generator
+    std::vector<Uint32> mRandom;
+
+    //Steps a slot's generator
+    int random(int slot, int range);
+
+    //Slots in total and slots handed out to emitters
+    int mCapacity;
+    int mUsed;
 };
 
-inline Particle::Particle(const int x, const int y, const int duration) {
-    //Set offsets
-    mPosX = x - 8 + (rand() % 13);
-    mPosY = y - 8 + (rand() % 13);
+/*---------------------*
+LParticlePool functions
+-----------------------*/
+
+//Allocates every slot up front
+inline LParticlePool::LParticlePool(const int capacity) : mPosX(capacity), mPosY(capacity), mFrame(capacity), mDuration(capacity), mTexture(capacity), mRandom(capacity) {
+    mCapacity = capacity;
+    mUsed = 0;
+
+    //Seed every slot differently, never zero
+    for (int i = 0; i < capacity; ++i) {
+        mRandom[i] = (static_cast<Uint32>(i) + 1) * 2654435761u | 1;
+    }
+}
+
+//Reserves a range of slots for one emitter
+inline int LParticlePool::addEmitter(const int count) {
+    //Pool is exhausted
+    if (mUsed + count > mCapacity) {
+        printf("Warning: Particle pool is full, emitter of %d particles dropped!\n", count);
+        return -1;
+    }
+
+    //Slots start dead so the first emit spawns them
+    const int first = mUsed;
+    for (int i = first; i < first + count; ++i) {
+        mFrame[i] = 1;
+        mDuration[i] = 0;
+        mTexture[i] = nullptr;
+    }
+    mUsed += count;
+
+    return first;
+}
+
+//Respawns the dead particles of an emitter around given point
+inline void LParticlePool::emit(const int first, const int count, const int x, const int y, const int duration, const LTextureRegion* texture) {
+    for (int i = first; i < first + count; ++i) {
+        //Reuse dead slot in place
+        if (isDead(i)) {
+            //Set offsets
+            mPosX[i] = x - 8 + random(i, 13);
+            mPosY[i] = y - 8 + random(i, 13);
+
+            //Initialize animation
+            mFrame[i] = random(i, 10);
+
+            //Set animation duration
+            mDuration[i] = duration;
+
+            //Set type
+            mTexture[i] = texture;
+        }
+    }
+}
 
-    //Initialize animation
-    mFrame = rand() % 10;
+//Animates the particles of an emitter
+inline void LParticlePool::update(const int first, const int count) {
+    for (int i = first; i < first + count; ++i) {
+        //Dead slots wait for the next emit
+        if (!isDead(i)) {
+            mFrame[i]++;
+        }
+    }
+}
 
-    //Set animation duration
-    mDuration = duration;
+//Shows the particles of an emitter
+inline void LParticlePool::render(SDL_Renderer* mRenderer, const int first, const int count, const int camX, const int camY) const {
+    for (int i = first; i < first + count; ++i) {
+        //Dead slots wait for the next emit
+        if (isDead(i) || mTexture[i] == nullptr) {
+            continue;
+        }
+
+        //Show image
+        gSpriteBatch.draw(mRenderer, *mTexture[i], mPosX[i] - camX, mPosY[i] - camY, nullptr, static_cast<Uint8>(255.0 * (1.0 - static_cast<float>(mFrame[i]) / mDuration[i])));
+    }
+}
 
-    //Set type
-    mTexture = &gShimmerTexture;
+//Checks if particle is dead
+inline bool LParticlePool::isDead(const int slot) const {
+    return mFrame[slot] > mDuration[slot];
 }
 
-inline void Particle::render(SDL_Renderer* mRenderer, const int camX, const int camY) {
-    //Show image
-    mTexture->renderOnce(mRenderer, static_cast<Uint8>(255.0 * (1.0 - static_cast<float>(mFrame) / mDuration)), mPosX - camX, mPosY - camY);
+//Steps a slot's generator, xorshift keeps it to a few instructions
+inline int LParticlePool::random(const int slot, const int range) {
+    Uint32 state = mRandom[slot];
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    mRandom[slot] = state;
+    return static_cast<int>(state % static_cast<Uint32>(range));
+}
 
-    //Animate
-    mFrame++;
+inline int LParticlePool::getCapacity() const {
+    return mCapacity;
 }
 
-inline bool Particle::isDead() {
-    return mFrame > mDuration;
+inline int LParticlePool::getUsed() const {
+    return mUsed;
 }
 
+/*-----*
+Objects
+-------*/
+
+//Particles of every emitter
+extern LParticlePool gParticlePool;
+
 #endif //LPARTICLE_H
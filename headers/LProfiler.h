@@ -0,0 +1,281 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LPROFILER_H
+#define LPROFILER_H
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <SDL.h>
+#include "LHighResTimer.h"
+
+//Frames kept in the ring buffer
+inline constexpr int PROFILER_FRAME_CAPACITY = 600;
+
+//Zones recorded per frame, extra zones are dropped
+inline constexpr int PROFILER_MAX_ZONES = 256;
+
+//One timed zone
+struct ProfileSample {
+    const char* name;
+    Uint64 start;
+    Uint64 duration;
+};
+
+//One frame of timed zones
+struct ProfileFrame {
+    Uint64 start;
+    Uint64 duration;
+    int totalSamples;
+    ProfileSample samples[PROFILER_MAX_ZONES];
+};
+
+//Records timed zones per frame into a ring buffer
+class LProfiler {
+public:
+    //Initializes variables
+    LProfiler();
+
+    //Turns recording on or off
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    //Marks frame boundaries
+    void beginFrame();
+    void endFrame();
+
+    //Opens a zone, returns its slot or -1 if it was dropped
+    int beginZone(const char* name);
+
+    //Closes a zone opened this frame
+    void endZone(int slot);
+
+    //Records a zone timed elsewhere that ends now, such as work done on another thread
+    void recordZone(const char* name, Uint64 duration);
+
+    //Writes the recorded frames as Chrome trace-event JSON
+    bool exportChromeTrace(const std::string& path) const;
+
+    //Gets number of frames held in the ring buffer
+    int getRecordedFrames() const;
+
+private:
+    //The ring buffer of frames, allocated when first enabled
+    std::vector<ProfileFrame> mFrames;
+
+    //Slot of the frame being recorded
+    int mCurrentFrame;
+
+    //Frames recorded since enabling
+    int mRecordedFrames;
+
+    //Whether a frame is open
+    bool mInFrame;
+
+    //Recording flag
+    bool mEnabled;
+
+    //The profiling clock
+    LHighResTimer mClock;
+};
+
+//Times the enclosing scope
+class LProfileZone {
+public:
+    //Opens the zone
+    explicit LProfileZone(const char* name);
+
+    //Closes the zone
+    ~LProfileZone();
+
+    //Zones are tied to their scope
+    LProfileZone(const LProfileZone&) = delete;
+    LProfileZone& operator=(const LProfileZone&) = delete;
+
+private:
+    //Slot of the zone in the current frame
+    int mSlot;
+};
+
+//Scoped zone markers, compiled out entirely with DISABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#ifdef DISABLE_PROFILER
+#define PROFILE_ZONE(name)
+#define PROFILE_RECORD(name, duration)
+#else
+#define PROFILE_ZONE(name) LProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_RECORD(name, duration) gProfiler.recordZone(name, duration)
+#endif
+
+/*------------------*
+LProfiler functions
+--------------------*/
+
+//Initializes variables
+inline LProfiler::LProfiler() {
+    mCurrentFrame = 0;
+    mRecordedFrames = 0;
+    mInFrame = false;
+    mEnabled = false;
+}
+
+//Turns recording on or off
+inline void LProfiler::setEnabled(const bool enabled) {
+    if (enabled && !mEnabled) {
+        //Allocate the ring buffer once and start fresh
+        if (mFrames.empty()) {
+            mFrames.resize(PROFILER_FRAME_CAPACITY);
+        }
+        mCurrentFrame = 0;
+        mRecordedFrames = 0;
+        mClock.start();
+    }
+    mEnabled = enabled;
+    mInFrame = false;
+}
+
+inline bool LProfiler::isEnabled() const {
+    return mEnabled;
+}
+
+//Marks frame boundaries
+inline void LProfiler::beginFrame() {
+    if (!mEnabled) {
+        return;
+    }
+
+    //Start a fresh slot
+    ProfileFrame& frame = mFrames[mCurrentFrame];
+    frame.start = mClock.getTicks();
+    frame.duration = 0;
+    frame.totalSamples = 0;
+    mInFrame = true;
+}
+
+inline void LProfiler::endFrame() {
+    if (!mEnabled || !mInFrame) {
+        return;
+    }
+
+    //Close the frame and move to the next slot
+    ProfileFrame& frame = mFrames[mCurrentFrame];
+    frame.duration = mClock.getTicks() - frame.start;
+    mCurrentFrame = (mCurrentFrame + 1) % PROFILER_FRAME_CAPACITY;
+    if (mRecordedFrames < PROFILER_FRAME_CAPACITY) {
+        ++mRecordedFrames;
+    }
+    mInFrame = false;
+}
+
+//Opens a zone, returns its slot or -1 if it was dropped
+inline int LProfiler::beginZone(const char* name) {
+    if (!mEnabled || !mInFrame) {
+        return -1;
+    }
+
+    ProfileFrame& frame = mFrames[mCurrentFrame];
+    if (frame.totalSamples >= PROFILER_MAX_ZONES) {
+        return -1;
+    }
+
+    //Record the zone start
+    const int slot = frame.totalSamples++;
+    frame.samples[slot].name = name;
+    frame.samples[slot].start = mClock.getTicks();
+    frame.samples[slot].duration = 0;
+    return slot;
+}
+
+//Closes a zone opened this frame
+inline void LProfiler::endZone(const int slot) {
+    if (slot < 0 || !mEnabled || !mInFrame) {
+        return;
+    }
+
+    ProfileSample& sample = mFrames[mCurrentFrame].samples[slot];
+    sample.duration = mClock.getTicks() - sample.start;
+}
+
+//Records a zone timed elsewhere that ends now
+inline void LProfiler::recordZone(const char* name, const Uint64 duration) {
+    if (!mEnabled || !mInFrame) {
+        return;
+    }
+
+    ProfileFrame& frame = mFrames[mCurrentFrame];
+    if (frame.totalSamples >= PROFILER_MAX_ZONES) {
+        return;
+    }
+
+    //Place it before now, it may reach back past the frame start
+    const Uint64 now = mClock.getTicks();
+    ProfileSample& sample = frame.samples[frame.totalSamples++];
+    sample.name = name;
+    sample.start = now - std::min(now, duration);
+    sample.duration = now - sample.start;
+}
+
+//Writes the recorded frames as Chrome trace-event JSON
+inline bool LProfiler::exportChromeTrace(const std::string& path) const {
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        printf("Unable to open %s for the profile trace!\n", path.c_str());
+        return false;
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+
+    //Oldest frame first
+    bool first = true;
+    const int oldest = (mCurrentFrame - mRecordedFrames + PROFILER_FRAME_CAPACITY) % PROFILER_FRAME_CAPACITY;
+    for (int i = 0; i < mRecordedFrames; ++i) {
+        const ProfileFrame& frame = mFrames[(oldest + i) % PROFILER_FRAME_CAPACITY];
+
+        //Complete events take microseconds
+        fprintf(file, "%s{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", first ? "" : ",\n", frame.start / 1000.0, frame.duration / 1000.0);
+        first = false;
+        for (int j = 0; j < frame.totalSamples; ++j) {
+            const ProfileSample& sample = frame.samples[j];
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", sample.name, sample.start / 1000.0, sample.duration / 1000.0);
+        }
+    }
+
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+
+    printf("Wrote %d profiled frames to %s\n", mRecordedFrames, path.c_str());
+    return true;
+}
+
+//Gets number of frames held in the ring buffer
+inline int LProfiler::getRecordedFrames() const {
+    return mRecordedFrames;
+}
+
+/*-----*
+Objects
+-------*/
+
+//The frame profiler
+inline LProfiler gProfiler;
+
+/*---------------------*
+LProfileZone functions
+-----------------------*/
+
+//Opens the zone
+inline LProfileZone::LProfileZone(const char* name) {
+    mSlot = gProfiler.isEnabled() ? gProfiler.beginZone(name) : -1;
+}
+
+//Closes the zone
+inline LProfileZone::~LProfileZone() {
+    if (mSlot >= 0) {
+        gProfiler.endZone(mSlot);
+    }
+}
+
+#endif //LPROFILER_H
@@ -0,0 +1,81 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LSPSCQUEUE_H
+#define LSPSCQUEUE_H
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+//Fixed capacity ring shared by exactly one producer thread and one consumer thread without locks
+template <typename T, size_t Capacity>
+class LSPSCQueue {
+public:
+    //Initializes variables
+    LSPSCQueue();
+
+    //Copies an item in, fails when full, producer only
+    bool push(const T& item);
+
+    //Copies the oldest item out, fails when empty, consumer only
+    bool pop(T& item);
+
+    //Checks if nothing is queued
+    bool isEmpty() const;
+
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of two");
+
+    //Queued items
+    std::array<T, Capacity> mItems;
+
+    //Next slot to read and to write, kept on separate cache lines so the threads do not contend
+    alignas(64) std::atomic<size_t> mHead;
+    alignas(64) std::atomic<size_t> mTail;
+};
+
+/*--------------------*
+LSPSCQueue functions
+----------------------*/
+
+//Initializes variables
+template <typename T, size_t Capacity>
+LSPSCQueue<T, Capacity>::LSPSCQueue() : mItems(), mHead(0), mTail(0) {
+}
+
+//Copies an item in, fails when full
+template <typename T, size_t Capacity>
+bool LSPSCQueue<T, Capacity>::push(const T& item) {
+    const size_t tail = mTail.load(std::memory_order_relaxed);
+    if (tail - mHead.load(std::memory_order_acquire) == Capacity) {
+        return false;
+    }
+
+    //Publish the item after it is written
+    mItems[tail & (Capacity - 1)] = item;
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+//Copies the oldest item out, fails when empty
+template <typename T, size_t Capacity>
+bool LSPSCQueue<T, Capacity>::pop(T& item) {
+    const size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mTail.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    //Hand the slot back after it is read
+    item = mItems[head & (Capacity - 1)];
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+//Checks if nothing is queued
+template <typename T, size_t Capacity>
+bool LSPSCQueue<T, Capacity>::isEmpty() const {
+    return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+}
+
+#endif //LSPSCQUEUE_H
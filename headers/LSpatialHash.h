@@ -0,0 +1,206 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LSPATIALHASH_H
+#define LSPATIALHASH_H
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//Most cells per circle, sparse levels get wider cells rather than huge grids
+inline constexpr int SPATIAL_HASH_CELLS_PER_CIRCLE = 4;
+
+//Two circles that may touch, a is always the lower index
+struct LCollisionPair {
+    int a;
+    int b;
+};
+
+//Moving circles binned by a counting sort into grid cells, rebuilt every tick,
+//only circles in neighbouring cells are paired up for the narrowphase
+class LSpatialHash {
+public:
+    //Initializes variables
+    LSpatialHash();
+
+    //Bins circles given as one array per field, cells are at least as wide as the largest circle
+    void build(const float* x, const float* y, const int* radius, int count);
+
+    //Replaces pairs with every pair of circles whose bounding boxes overlap, each pair once
+    void findPairs(std::vector<LCollisionPair>& pairs) const;
+
+    //Gets number of circles binned
+    int getCount() const;
+
+    //Gets width of a cell
+    float getCellSize() const;
+
+private:
+    //Cells are keyed by their row-major index over the circles' bounds, so a cell's right neighbour
+    //is the next key and a row of three neighbours is one run of the sorted arrays
+    int getCell(float x, float y) const;
+
+    //Where each cell's circles start in the sorted arrays, one extra entry ends the last
+    std::vector<int> mCellStart;
+
+    //Cell of each circle in the order given
+    std::vector<int> mCellOf;
+
+    //Circles sorted by cell so neighbours are read together, with their cell and given index
+    std::vector<float> mX, mY;
+    std::vector<int> mRadius;
+    std::vector<int> mCell;
+    std::vector<int> mIndex;
+
+    //Top left corner of the grid and its size in cells
+    float mLeft, mTop;
+    int mColumns, mRows;
+
+    //Circles binned
+    int mCount;
+
+    //Cell width
+    float mCellSize;
+};
+
+/*----------------------*
+LSpatialHash functions
+------------------------*/
+
+//Initializes variables
+inline LSpatialHash::LSpatialHash() {
+    mLeft = 0.f;
+    mTop = 0.f;
+    mColumns = 0;
+    mRows = 0;
+    mCount = 0;
+    mCellSize = 1.f;
+}
+
+//Bins circles
+inline void LSpatialHash::build(const float* x, const float* y, const int* radius, const int count) {
+    mCount = std::max(0, count);
+    mColumns = 0;
+    mRows = 0;
+    if (mCount == 0) {
+        mCellStart.assign(1, 0);
+        return;
+    }
+
+    //Bounds of every centre
+    int largestRadius = 0;
+    float right = x[0], bottom = y[0];
+    mLeft = x[0];
+    mTop = y[0];
+    for (int i = 0; i < mCount; ++i) {
+        largestRadius = std::max(largestRadius, radius[i]);
+        mLeft = std::min(mLeft, x[i]);
+        mTop = std::min(mTop, y[i]);
+        right = std::max(right, x[i]);
+        bottom = std::max(bottom, y[i]);
+    }
+
+    //Circles that touch have centres less than two of the largest radius apart, so in the same or a neighbouring cell
+    mCellSize = static_cast<float>(std::max(1, 2 * largestRadius));
+    while (true) {
+        mColumns = static_cast<int>((right - mLeft) / mCellSize) + 1;
+        mRows = static_cast<int>((bottom - mTop) / mCellSize) + 1;
+        if (static_cast<long long>(mColumns) * mRows <= static_cast<long long>(SPATIAL_HASH_CELLS_PER_CIRCLE) * mCount + 1) {
+            break;
+        }
+        mCellSize *= 2.f;
+    }
+
+    //Every array only grows, so steady ticks never allocate
+    const int cells = mColumns * mRows;
+    mCellStart.assign(cells + 1, 0);
+    mCellOf.resize(mCount);
+    for (auto* component : {&mX, &mY}) {
+        component->resize(mCount);
+    }
+    for (auto* component : {&mRadius, &mCell, &mIndex}) {
+        component->resize(mCount);
+    }
+
+    //Count circles per cell
+    for (int i = 0; i < mCount; ++i) {
+        mCellOf[i] = getCell(x[i], y[i]);
+        ++mCellStart[mCellOf[i] + 1];
+    }
+
+    //Turn counts into where each cell starts
+    for (int i = 0; i < cells; ++i) {
+        mCellStart[i + 1] += mCellStart[i];
+    }
+
+    //Scatter circles into their cells, each start moves up as it fills and ends where the next cell starts
+    for (int i = 0; i < mCount; ++i) {
+        const int slot = mCellStart[mCellOf[i]]++;
+        mX[slot] = x[i];
+        mY[slot] = y[i];
+        mRadius[slot] = radius[i];
+        mCell[slot] = mCellOf[i];
+        mIndex[slot] = i;
+    }
+
+    //Shift the starts back into place
+    for (int i = cells; i > 0; --i) {
+        mCellStart[i] = mCellStart[i - 1];
+    }
+    mCellStart[0] = 0;
+}
+
+//Pairs up circles in neighbouring cells
+inline void LSpatialHash::findPairs(std::vector<LCollisionPair>& pairs) const {
+    pairs.clear();
+
+    for (int i = 0; i < mCount; ++i) {
+        const int column = mCell[i] % mColumns;
+        const int row = mCell[i] / mColumns;
+
+        //Looking forward only so each pair comes up once: the rest of this cell and the one to the right,
+        //then the three cells below
+        int runs[2][2];
+        int runCount = 0;
+        runs[runCount][0] = i + 1;
+        runs[runCount][1] = mCellStart[mCell[i] + (column + 1 < mColumns ? 2 : 1)];
+        ++runCount;
+        if (row + 1 < mRows) {
+            const int below = mCell[i] + mColumns;
+            runs[runCount][0] = mCellStart[below - (column > 0 ? 1 : 0)];
+            runs[runCount][1] = mCellStart[below + (column + 1 < mColumns ? 2 : 1)];
+            ++runCount;
+        }
+
+        for (int run = 0; run < runCount; ++run) {
+            for (int j = runs[run][0]; j < runs[run][1]; ++j) {
+                //Cheap box test before the narrowphase sees the pair
+                const float reach = static_cast<float>(mRadius[i] + mRadius[j]);
+                if (std::abs(mX[j] - mX[i]) < reach && std::abs(mY[j] - mY[i]) < reach) {
+                    pairs.push_back({std::min(mIndex[i], mIndex[j]), std::max(mIndex[i], mIndex[j])});
+                }
+            }
+        }
+    }
+}
+
+//Gets number of circles binned
+inline int LSpatialHash::getCount() const {
+    return mCount;
+}
+
+//Gets width of a cell
+inline float LSpatialHash::getCellSize() const {
+    return mCellSize;
+}
+
+//Cell a point falls in
+inline int LSpatialHash::getCell(const float x, const float y) const {
+    //Offsets from the corner are never negative, so truncating rounds down
+    const int column = std::min(mColumns - 1, static_cast<int>((x - mLeft) / mCellSize));
+    const int row = std::min(mRows - 1, static_cast<int>((y - mTop) / mCellSize));
+    return row * mColumns + column;
+}
+
+#endif //LSPATIALHASH_H
@@ -0,0 +1,175 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LSPRITEBATCH_H
+#define LSPRITEBATCH_H
+#include <vector>
+#include <SDL.h>
+#include "LTexture.h"
+#include "LTextureAtlas.h"
+
+//Collects textured quads and submits each run of one texture with a single SDL_RenderGeometry call
+class LSpriteBatch {
+public:
+    //Initializes variables
+    LSpriteBatch();
+
+    //Queues a quad of a texture, flushing first when the texture or renderer changes
+    void draw(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination, SDL_Color color = {0xFF, 0xFF, 0xFF, 0xFF});
+
+    //Queues a texture at given point like LTexture::renderOnce
+    void draw(SDL_Renderer* renderer, const LTexture& texture, int x, int y, const SDL_Rect* clip = nullptr, Uint8 alpha = 0xFF);
+
+    //Queues an atlas region at given point like LTextureRegion::renderOnce
+    void draw(SDL_Renderer* renderer, const LTextureRegion& region, int x, int y, const SDL_Rect* clip = nullptr, Uint8 alpha = 0xFF);
+
+    //Submits the queued quads
+    void flush();
+
+    //Gets the statistics since the last reset
+    int getDrawCalls() const;
+    int getQuads() const;
+    void resetStatistics();
+
+private:
+    //Renderer the quads go to
+    SDL_Renderer* mRenderer;
+
+    //Texture of the queued quads
+    SDL_Texture* mTexture;
+
+    //Its dimensions, for texture coordinates
+    float mTextureWidth;
+    float mTextureHeight;
+
+    //Queued quads, the index pattern is built once and reused
+    std::vector<SDL_Vertex> mVertices;
+    std::vector<int> mIndices;
+
+    //Statistics
+    int mDrawCalls;
+    int mQuads;
+};
+
+/*---------------------*
+LSpriteBatch functions
+-----------------------*/
+
+//Initializes variables
+inline LSpriteBatch::LSpriteBatch() {
+    mRenderer = nullptr;
+    mTexture = nullptr;
+    mTextureWidth = 1;
+    mTextureHeight = 1;
+    mDrawCalls = 0;
+    mQuads = 0;
+}
+
+//Queues a quad of a texture, flushing first when the texture or renderer changes
+inline void LSpriteBatch::draw(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination, const SDL_Color color) {
+    if (texture == nullptr) {
+        return;
+    }
+
+    //Start a new run for a different texture
+    if (texture != mTexture || renderer != mRenderer) {
+        flush();
+        mRenderer = renderer;
+        mTexture = texture;
+
+        int width = 1, height = 1;
+        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+        mTextureWidth = static_cast<float>(width);
+        mTextureHeight = static_cast<float>(height);
+    }
+
+    //Quad corners on screen and in the texture
+    const float left = static_cast<float>(destination.x);
+    const float top = static_cast<float>(destination.y);
+    const float right = left + destination.w;
+    const float bottom = top + destination.h;
+    const float u0 = source.x / mTextureWidth;
+    const float v0 = source.y / mTextureHeight;
+    const float u1 = (source.x + source.w) / mTextureWidth;
+    const float v1 = (source.y + source.h) / mTextureHeight;
+
+    mVertices.push_back({{left, top}, color, {u0, v0}});
+    mVertices.push_back({{right, top}, color, {u1, v0}});
+    mVertices.push_back({{right, bottom}, color, {u1, v1}});
+    mVertices.push_back({{left, bottom}, color, {u0, v1}});
+
+    //Two triangles per quad, only grown for the largest run seen
+    const int quads = static_cast<int>(mVertices.size()) / 4;
+    if (static_cast<int>(mIndices.size()) < quads * 6) {
+        const int first = (quads - 1) * 4;
+        mIndices.push_back(first);
+        mIndices.push_back(first + 1);
+        mIndices.push_back(first + 2);
+        mIndices.push_back(first);
+        mIndices.push_back(first + 2);
+        mIndices.push_back(first + 3);
+    }
+
+    ++mQuads;
+}
+
+//Queues a texture at given point like LTexture::renderOnce
+inline void LSpriteBatch::draw(SDL_Renderer* renderer, const LTexture& texture, const int x, const int y, const SDL_Rect* clip, const Uint8 alpha) {
+    //Whole texture unless clipped
+    const SDL_Rect source = clip != nullptr ? *clip : SDL_Rect{0, 0, texture.getWidth(), texture.getHeight()};
+    const SDL_Rect destination = {x, y, source.w, source.h};
+
+    //Combine with the texture's own alpha modulation
+    const Uint8 combinedAlpha = static_cast<Uint8>(alpha * texture.getAlpha() / 255);
+    draw(renderer, texture.getTexture(), source, destination, {0xFF, 0xFF, 0xFF, combinedAlpha});
+}
+
+//Queues an atlas region at given point like LTextureRegion::renderOnce
+inline void LSpriteBatch::draw(SDL_Renderer* renderer, const LTextureRegion& region, const int x, const int y, const SDL_Rect* clip, const Uint8 alpha) {
+    //Clip is relative to the region
+    const SDL_Rect source = region.getSource(clip);
+    const SDL_Rect destination = {x, y, source.w, source.h};
+
+    //Combine with the region's own alpha modulation
+    const Uint8 combinedAlpha = static_cast<Uint8>(alpha * region.getAlpha() / 255);
+    draw(renderer, region.getTexture(), source, destination, {0xFF, 0xFF, 0xFF, combinedAlpha});
+}
+
+//Submits the queued quads
+inline void LSpriteBatch::flush() {
+    if (mVertices.empty()) {
+        return;
+    }
+
+    //Render to screen
+    const int vertices = static_cast<int>(mVertices.size());
+    SDL_RenderGeometry(mRenderer, mTexture, mVertices.data(), vertices, mIndices.data(), vertices / 4 * 6);
+    ++mDrawCalls;
+
+    mVertices.clear();
+    mTexture = nullptr;
+}
+
+//Gets the statistics since the last reset
+inline int LSpriteBatch::getDrawCalls() const {
+    return mDrawCalls;
+}
+
+inline int LSpriteBatch::getQuads() const {
+    return mQuads;
+}
+
+inline void LSpriteBatch::resetStatistics() {
+    mDrawCalls = 0;
+    mQuads = 0;
+}
+
+/*-----*
+Objects
+-------*/
+
+//Batches the sprites of a frame
+extern LSpriteBatch gSpriteBatch;
+
+#endif //LSPRITEBATCH_H
@@ -0,0 +1,60 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LSTATEHASH_H
+#define LSTATEHASH_H
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+//FNV-1a over simulation state, two runs that hash the same ended in the same state without storing any frames
+class LStateHash {
+public:
+    //Initializes variables
+    LStateHash();
+
+    //Mixes in raw bytes
+    void add(const void* data, size_t size);
+
+    //Mixes in a value's bytes
+    template<typename T>
+    void add(const T& value);
+
+    //Gets the hash so far
+    uint64_t get() const;
+
+private:
+    uint64_t mHash;
+};
+
+/*--------------------*
+LStateHash functions
+----------------------*/
+
+//Initializes variables
+inline LStateHash::LStateHash() {
+    mHash = 14695981039346656037ull;
+}
+
+//Mixes in raw bytes
+inline void LStateHash::add(const void* data, const size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        mHash = (mHash ^ bytes[i]) * 1099511628211ull;
+    }
+}
+
+//Mixes in a value's bytes
+template<typename T>
+void LStateHash::add(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be hashed by their bytes");
+    add(&value, sizeof(T));
+}
+
+//Gets the hash so far
+inline uint64_t LStateHash::get() const {
+    return mHash;
+}
+
+#endif //LSTATEHASH_H
@@ -5,11 +5,13 @@
 #ifndef LTEXTURE_H
 #define LTEXTURE_H
 #include <string>
+#include <utility>
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <SDL_image.h>
+#include "SDLDeleter.h"
 
-//Texture wrapper class
+//Texture wrapper class, owns its texture so it moves but never copies
 class LTexture {
 public:
     //Initializes variables
@@ -17,9 +19,20 @@ public:
     //Deallocates memory
     ~LTexture();
 
+    //Takes over another texture without re-uploading it
+    LTexture(LTexture&& other) noexcept;
+    LTexture& operator=(LTexture&& other) noexcept;
+
+    //Two owners would destroy the texture twice
+    LTexture(const LTexture&) = delete;
+    LTexture& operator=(const LTexture&) = delete;
+
     //Loads image at specified path
     bool loadFromFile(SDL_Renderer* mRenderer, const std::string& path);
 
+    //Creates texture from an already decoded image, the surface stays owned by the caller
+    bool loadFromSurface(SDL_Renderer* mRenderer, SDL_Surface* surface);
+
     //Creates image from font string
     bool loadFromRenderedText(SDL_Renderer* mRenderer, TTF_Font* mFont, const std::string& textureText, SDL_Color textColor);
 
@@ -44,9 +57,15 @@ public:
     int getWidth() const;
     int getHeight() const;
 
+    //Gets alpha modulation
+    Uint8 getAlpha() const;
+
+    //Gets the hardware texture
+    SDL_Texture* getTexture() const;
+
 private:
     //The actual hardware texture
-    SDL_Texture* mTexture;
+    UniqueTexture mTexture;
 
     //Image dimensions
     int mWidth;
@@ -74,38 +93,72 @@ inline LTexture::~LTexture() {
     free();
 }
 
+//Takes over another texture
+inline LTexture::LTexture(LTexture&& other) noexcept {
+    mTexture = std::move(other.mTexture);
+    mWidth = std::exchange(other.mWidth, 0);
+    mHeight = std::exchange(other.mHeight, 0);
+    mAlpha = std::exchange(other.mAlpha, 255);
+}
+
+inline LTexture& LTexture::operator=(LTexture&& other) noexcept {
+    if (this != &other) {
+        mTexture = std::move(other.mTexture);
+        mWidth = std::exchange(other.mWidth, 0);
+        mHeight = std::exchange(other.mHeight, 0);
+        mAlpha = std::exchange(other.mAlpha, 255);
+    }
+    return *this;
+}
+
 //Loads image at specified path
 inline bool LTexture::loadFromFile(SDL_Renderer* mRenderer, const std::string& path) {
     //Get rid of preexisting texture
     free();
 
-    //The final texture
-    SDL_Texture* newTexture = nullptr;
-
     //Load image at specified path
     if (SDL_Surface* loadedSurface = IMG_Load(path.c_str()); loadedSurface == nullptr) {
         printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
     }
     else {
-        //Color key image
-        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0x00, 0xFF, 0xFF));
-
         //Create texture from surface pixels
-        newTexture = SDL_CreateTextureFromSurface(mRenderer, loadedSurface);
-        if (newTexture == nullptr) {
-            printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
-        }
-        else {
-            //Get image dimensions
-            mWidth = loadedSurface->w;
-            mHeight = loadedSurface->h;
+        if (!loadFromSurface(mRenderer, loadedSurface)) {
+            printf("Unable to create texture from %s!\n", path.c_str());
         }
         //Ged rif of old loaded surface
         SDL_FreeSurface(loadedSurface);
     }
 
     //Return success
-    mTexture = newTexture;
+    return mTexture != nullptr;
+}
+
+//Creates texture from an already decoded image
+inline bool LTexture::loadFromSurface(SDL_Renderer* mRenderer, SDL_Surface* surface) {
+    //Get rid of preexisting texture
+    free();
+
+    //Color key a copy, the asset cache shares the image with other holders
+    SDL_Surface* keyedSurface = SDL_DuplicateSurface(surface);
+    if (keyedSurface == nullptr) {
+        printf("Unable to copy image! SDL Error: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetColorKey(keyedSurface, SDL_TRUE, SDL_MapRGB(keyedSurface->format, 0x00, 0xFF, 0xFF));
+
+    //Create texture from surface pixels
+    mTexture.reset(SDL_CreateTextureFromSurface(mRenderer, keyedSurface));
+    if (mTexture == nullptr) {
+        printf("Unable to create texture! SDL Error: %s\n", SDL_GetError());
+    }
+    else {
+        //Get image dimensions
+        mWidth = keyedSurface->w;
+        mHeight = keyedSurface->h;
+    }
+    SDL_FreeSurface(keyedSurface);
+
+    //Return success
     return mTexture != nullptr;
 }
 
@@ -120,7 +173,7 @@ inline bool LTexture::loadFromRenderedText(SDL_Renderer* mRenderer, TTF_Font* mF
     }
     else {
         //Create texture from surface pixels
-        mTexture = SDL_CreateTextureFromSurface(mRenderer, textSurface);
+        mTexture.reset(SDL_CreateTextureFromSurface(mRenderer, textSurface));
         if (mTexture == nullptr) {
             printf("Unable to create texture from rendered text! SDL Error: %s\n", SDL_GetError());
         }
@@ -141,8 +194,7 @@ inline bool LTexture::loadFromRenderedText(SDL_Renderer* mRenderer, TTF_Font* mF
 //Deallocates texture
 inline void LTexture::free() {
     if (mTexture != nullptr) {
-        SDL_DestroyTexture(mTexture);
-        mTexture = nullptr;
+        mTexture.reset();
         mWidth = 0;
         mHeight = 0;
     }
@@ -151,13 +203,13 @@ inline void LTexture::free() {
 //Set color modulation
 inline void LTexture::setColor(const Uint8 red, const Uint8 green, const Uint8 blue) {
     //Modulate texture
-    SDL_SetTextureColorMod(mTexture, red, green, blue);
+    SDL_SetTextureColorMod(mTexture.get(), red, green, blue);
 }
 
 //Set blending
 inline void LTexture::setBlendMode(const SDL_BlendMode blending) {
     //Set blending function
-    SDL_SetTextureBlendMode(mTexture, blending);
+    SDL_SetTextureBlendMode(mTexture.get(), blending);
 }
 
 //Set alpha modulation
@@ -165,7 +217,7 @@ inline void LTexture::setAlpha(const Uint8 alpha) {
     //Set alpha value
     mAlpha = alpha;
     //Modulate texture alpha
-    SDL_SetTextureAlphaMod(mTexture, alpha);
+    SDL_SetTextureAlphaMod(mTexture.get(), alpha);
 }
 
 //Renders texture at given point
@@ -181,7 +233,7 @@ inline void LTexture::render(SDL_Renderer* mRenderer, const int x, const int y,
     }
 
     //Render to screen
-    SDL_RenderCopyEx(mRenderer, mTexture, clip, &renderQuad, angle, center, flip);
+    SDL_RenderCopyEx(mRenderer, mTexture.get(), clip, &renderQuad, angle, center, flip);
 }
 
 //Renders texture at given point
@@ -196,10 +248,10 @@ inline void LTexture::renderOnce(SDL_Renderer* mRenderer, const Uint8 alpha ,con
         renderQuad.h = clip->h;
     }
 
-    SDL_SetTextureAlphaMod(mTexture, alpha);
+    SDL_SetTextureAlphaMod(mTexture.get(), alpha);
     //Render to screen
-    SDL_RenderCopyEx(mRenderer, mTexture, clip, &renderQuad, angle, center, flip);
-    SDL_SetTextureAlphaMod(mTexture, mAlpha);
+    SDL_RenderCopyEx(mRenderer, mTexture.get(), clip, &renderQuad, angle, center, flip);
+    SDL_SetTextureAlphaMod(mTexture.get(), mAlpha);
 }
 
 //Gets image dimensions
@@ -211,17 +263,14 @@ inline int LTexture::getHeight() const {
     return mHeight;
 }
 
-/*-----*
-Objects
--------*/
-
-//Text texture
-extern LTexture gFPSTextTexture;
-
-//Tile sprite sheet
-extern LTexture gTileTexture;
+//Gets alpha modulation
+inline Uint8 LTexture::getAlpha() const {
+    return mAlpha;
+}
 
-//Shimmer texture
-extern LTexture gShimmerTexture;
+//Gets the hardware texture
+inline SDL_Texture* LTexture::getTexture() const {
+    return mTexture.get();
+}
 
 #endif //LTEXTURE_H
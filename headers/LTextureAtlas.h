@@ -0,0 +1,377 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LTEXTUREATLAS_H
+#define LTEXTUREATLAS_H
+#include <SDL.h>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "SDLDeleter.h"
+
+//Largest atlas page, clamped further by the renderer's limit
+inline constexpr int ATLAS_PAGE_SIZE = 2048;
+
+//Transparent gap between packed images so filtering does not bleed neighbours in
+inline constexpr int ATLAS_PADDING = 1;
+
+//Part of an atlas page that draws like an LTexture
+class LTextureRegion {
+public:
+    //Initializes variables
+    LTextureRegion();
+    LTextureRegion(SDL_Texture* page, const SDL_Rect& area);
+
+    //Forgets the page, the atlas owns it
+    void free();
+
+    //Set alpha modulation
+    void setAlpha(Uint8 alpha);
+
+    //Renders region at given point, clip is relative to the region
+    void render(SDL_Renderer* mRenderer, int x, int y, const SDL_Rect* clip = nullptr, double angle = 0.0, const SDL_Point* center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE) const;
+
+    void renderOnce(SDL_Renderer *mRenderer, Uint8 alpha, int x, int y, const SDL_Rect *clip = nullptr, double angle = 0.0, const SDL_Point *center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE) const;
+
+    //Gets a clip of the region in page coordinates
+    SDL_Rect getSource(const SDL_Rect* clip = nullptr) const;
+
+    //Gets image dimensions
+    int getWidth() const;
+    int getHeight() const;
+
+    //Gets alpha modulation
+    Uint8 getAlpha() const;
+
+    //Gets the page holding the region
+    SDL_Texture* getTexture() const;
+
+private:
+    //The atlas page
+    SDL_Texture* mPage;
+
+    //Where the image sits in the page
+    SDL_Rect mArea;
+
+    Uint8 mAlpha;
+};
+
+//Packs many images into a few pages so they can share draw calls
+class LTextureAtlas {
+public:
+    //Deallocates memory
+    ~LTextureAtlas();
+
+    //Queues a decoded image for packing, the surface stays owned by the caller
+    void addImage(const std::string& name, SDL_Surface* surface);
+
+    //Packs every queued image into pages and uploads them
+    bool pack(SDL_Renderer* mRenderer);
+
+    //Redraws a packed image in place from a new decode of the same size, regions handed out stay valid
+    bool replaceImage(const std::string& name, SDL_Surface* surface);
+
+    //Gets a packed image, empty when unknown
+    LTextureRegion getRegion(const std::string& name) const;
+
+    //Deallocates pages
+    void free();
+
+    //Gets the number of pages
+    int getPageCount() const;
+
+private:
+    //An image waiting to be packed and, once packed, where it went
+    struct Entry {
+        std::string name;
+        SDL_Surface* surface;
+        int page;
+        SDL_Rect area;
+    };
+
+    //Color keys a copy of an image like LTexture does and draws it without blending, the image may be shared so it stays untouched
+    static bool blitKeyed(SDL_Surface* image, SDL_Surface* target, SDL_Rect* area);
+
+    //Queued and packed images
+    std::vector<Entry> mEntries;
+
+    //The page textures, null where a page failed so later pages keep their index
+    std::vector<UniqueTexture> mPages;
+};
+
+/*----------------------*
+LTextureRegion functions
+------------------------*/
+
+//Initializes variables
+inline LTextureRegion::LTextureRegion() {
+    mPage = nullptr;
+    mArea = {0, 0, 0, 0};
+    mAlpha = 255;
+}
+
+inline LTextureRegion::LTextureRegion(SDL_Texture* page, const SDL_Rect& area) {
+    mPage = page;
+    mArea = area;
+    mAlpha = 255;
+}
+
+//Forgets the page
+inline void LTextureRegion::free() {
+    mPage = nullptr;
+    mArea = {0, 0, 0, 0};
+}
+
+//Set alpha modulation
+inline void LTextureRegion::setAlpha(const Uint8 alpha) {
+    mAlpha = alpha;
+}
+
+//Renders region at given point
+inline void LTextureRegion::render(SDL_Renderer* mRenderer, const int x, const int y, const SDL_Rect* clip, const double angle, const SDL_Point* center, const SDL_RendererFlip flip) const {
+    renderOnce(mRenderer, mAlpha, x, y, clip, angle, center, flip);
+}
+
+//Renders region at given point with a one off alpha
+inline void LTextureRegion::renderOnce(SDL_Renderer* mRenderer, const Uint8 alpha, const int x, const int y, const SDL_Rect* clip, const double angle, const SDL_Point* center, const SDL_RendererFlip flip) const {
+    //Set rendering space and render to screen
+    const SDL_Rect source = getSource(clip);
+    const SDL_Rect renderQuad = {x, y, source.w, source.h};
+
+    //The page is shared, so alpha is put back afterwards
+    SDL_SetTextureAlphaMod(mPage, alpha);
+    SDL_RenderCopyEx(mRenderer, mPage, &source, &renderQuad, angle, center, flip);
+    SDL_SetTextureAlphaMod(mPage, 0xFF);
+}
+
+//Gets a clip of the region in page coordinates
+inline SDL_Rect LTextureRegion::getSource(const SDL_Rect* clip) const {
+    if (clip == nullptr) {
+        return mArea;
+    }
+    return {mArea.x + clip->x, mArea.y + clip->y, clip->w, clip->h};
+}
+
+//Gets image dimensions
+inline int LTextureRegion::getWidth() const {
+    return mArea.w;
+}
+
+inline int LTextureRegion::getHeight() const {
+    return mArea.h;
+}
+
+//Gets alpha modulation
+inline Uint8 LTextureRegion::getAlpha() const {
+    return mAlpha;
+}
+
+//Gets the page holding the region
+inline SDL_Texture* LTextureRegion::getTexture() const {
+    return mPage;
+}
+
+/*---------------------*
+LTextureAtlas functions
+-----------------------*/
+
+//Deallocates memory
+inline LTextureAtlas::~LTextureAtlas() {
+    free();
+}
+
+//Queues a decoded image for packing
+inline void LTextureAtlas::addImage(const std::string& name, SDL_Surface* surface) {
+    mEntries.push_back({name, surface, -1, {0, 0, surface->w, surface->h}});
+}
+
+//Packs every queued image into pages and uploads them
+inline bool LTextureAtlas::pack(SDL_Renderer* mRenderer) {
+    //Respect the renderer's texture size limit, zero means unbounded
+    int pageWidth = ATLAS_PAGE_SIZE, pageHeight = ATLAS_PAGE_SIZE;
+    if (SDL_RendererInfo info; SDL_GetRendererInfo(mRenderer, &info) == 0) {
+        if (info.max_texture_width > 0) {
+            pageWidth = std::min(pageWidth, info.max_texture_width);
+        }
+        if (info.max_texture_height > 0) {
+            pageHeight = std::min(pageHeight, info.max_texture_height);
+        }
+    }
+
+    //Tallest images first so shelves waste little height
+    std::vector<int> order(mEntries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](const int a, const int b) {
+        return mEntries[a].area.h > mEntries[b].area.h;
+    });
+
+    //Fill shelves left to right, open a new shelf or page when full
+    const int firstPage = static_cast<int>(mPages.size());
+    int page = firstPage, shelfX = 0, shelfY = 0, shelfHeight = 0;
+    std::vector<SDL_Point> pageSizes = {{0, 0}};
+    for (const int i : order) {
+        Entry& entry = mEntries[i];
+        if (entry.page >= 0) {
+            continue;
+        }
+        const int width = entry.area.w + ATLAS_PADDING;
+        const int height = entry.area.h + ATLAS_PADDING;
+        if (width > pageWidth || height > pageHeight) {
+            printf("Unable to pack %s, %dx%d is larger than an atlas page!\n", entry.name.c_str(), entry.area.w, entry.area.h);
+            return false;
+        }
+
+        if (shelfX + width > pageWidth) {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (shelfY + height > pageHeight) {
+            ++page;
+            shelfX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+            pageSizes.push_back({0, 0});
+        }
+
+        entry.page = page;
+        entry.area.x = shelfX;
+        entry.area.y = shelfY;
+        shelfX += width;
+        shelfHeight = std::max(shelfHeight, height);
+
+        //Pages only grow as large as what they hold
+        SDL_Point& size = pageSizes[page - firstPage];
+        size.x = std::max(size.x, shelfX);
+        size.y = std::max(size.y, shelfY + shelfHeight);
+    }
+
+    //Draw the images into their pages and upload them
+    bool success = true;
+    for (int i = 0; i < static_cast<int>(pageSizes.size()) && pageSizes[i].x > 0; ++i) {
+        SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, pageSizes[i].x, pageSizes[i].y, 32, SDL_PIXELFORMAT_RGBA32);
+        if (pageSurface == nullptr) {
+            printf("Unable to create atlas page surface! SDL Error: %s\n", SDL_GetError());
+            success = false;
+            mPages.emplace_back(nullptr);
+            continue;
+        }
+
+        for (Entry& entry : mEntries) {
+            if (entry.page == firstPage + i && entry.surface != nullptr) {
+                //Color key like LTexture does, then copy without blending onto the empty page
+                if (!blitKeyed(entry.surface, pageSurface, &entry.area)) {
+                    success = false;
+                }
+
+                //Packed images no longer need their surface
+                entry.surface = nullptr;
+            }
+        }
+
+        //Create texture from surface pixels
+        SDL_Texture* pageTexture = SDL_CreateTextureFromSurface(mRenderer, pageSurface);
+        if (pageTexture == nullptr) {
+            printf("Unable to create atlas page texture! SDL Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            SDL_SetTextureBlendMode(pageTexture, SDL_BLENDMODE_BLEND);
+        }
+        mPages.emplace_back(pageTexture);
+
+        //Get rid of page surface
+        SDL_FreeSurface(pageSurface);
+    }
+
+    return success;
+}
+
+//Redraws a packed image in place
+inline bool LTextureAtlas::replaceImage(const std::string& name, SDL_Surface* surface) {
+    for (const Entry& entry : mEntries) {
+        if (entry.name != name || entry.page < 0 || entry.page >= static_cast<int>(mPages.size()) || mPages[entry.page] == nullptr) {
+            continue;
+        }
+
+        //Other images sit right next to it, a new size needs a full repack
+        if (surface->w != entry.area.w || surface->h != entry.area.h) {
+            printf("Unable to replace %s, it changed size from %dx%d to %dx%d!\n", name.c_str(), entry.area.w, entry.area.h, surface->w, surface->h);
+            return false;
+        }
+
+        //Key and convert it the way pack does, then overwrite its part of the page
+        SDL_Surface* imageSurface = SDL_CreateRGBSurfaceWithFormat(0, surface->w, surface->h, 32, SDL_PIXELFORMAT_RGBA32);
+        if (imageSurface == nullptr) {
+            printf("Unable to create atlas image surface! SDL Error: %s\n", SDL_GetError());
+            return false;
+        }
+        if (!blitKeyed(surface, imageSurface, nullptr)) {
+            SDL_FreeSurface(imageSurface);
+            return false;
+        }
+
+        const bool success = SDL_UpdateTexture(mPages[entry.page].get(), &entry.area, imageSurface->pixels, imageSurface->pitch) == 0;
+        if (!success) {
+            printf("Unable to update atlas page! SDL Error: %s\n", SDL_GetError());
+        }
+        SDL_FreeSurface(imageSurface);
+        return success;
+    }
+
+    printf("Unable to replace %s, it is not in the atlas!\n", name.c_str());
+    return false;
+}
+
+//Color keys a copy of an image and draws it without blending
+inline bool LTextureAtlas::blitKeyed(SDL_Surface* image, SDL_Surface* target, SDL_Rect* area) {
+    //The asset cache hands the same surface to everyone, so key and blend state go on a private copy
+    SDL_Surface* copy = SDL_DuplicateSurface(image);
+    if (copy == nullptr) {
+        printf("Unable to copy atlas image! SDL Error: %s\n", SDL_GetError());
+        return false;
+    }
+    SDL_SetColorKey(copy, SDL_TRUE, SDL_MapRGB(copy->format, 0x00, 0xFF, 0xFF));
+    SDL_SetSurfaceBlendMode(copy, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(copy, nullptr, target, area);
+    SDL_FreeSurface(copy);
+    return true;
+}
+
+//Gets a packed image
+inline LTextureRegion LTextureAtlas::getRegion(const std::string& name) const {
+    for (const Entry& entry : mEntries) {
+        if (entry.name == name && entry.page >= 0 && entry.page < static_cast<int>(mPages.size()) && mPages[entry.page] != nullptr) {
+            return {mPages[entry.page].get(), entry.area};
+        }
+    }
+    return {};
+}
+
+//Deallocates pages
+inline void LTextureAtlas::free() {
+    mPages.clear();
+    mEntries.clear();
+}
+
+//Gets the number of pages
+inline int LTextureAtlas::getPageCount() const {
+    return static_cast<int>(mPages.size());
+}
+
+/*-----*
+Objects
+-------*/
+
+//Sprites of the level packed together
+extern LTextureAtlas gTextureAtlas;
+
+//Tile sprite sheet
+extern LTextureRegion gTileTexture;
+
+//Shimmer texture
+extern LTextureRegion gShimmerTexture;
+
+#endif //LTEXTUREATLAS_H
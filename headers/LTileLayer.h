@@ -0,0 +1,237 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LTILELAYER_H
+#define LTILELAYER_H
+#include <algorithm>
+#include <vector>
+#include <SDL.h>
+#include "global.h"
+#include "LCamera.h"
+#include "LTextureAtlas.h"
+#include "LSpriteBatch.h"
+#include "LTileMap.h"
+#include "SDLDeleter.h"
+
+//Largest chunk baked into one texture, clamped further by the renderer's limit
+inline constexpr int MAX_TILE_CHUNK_SIZE = 2048;
+
+//Largest level baked up front, bigger maps draw their visible tiles instead
+inline constexpr long long MAX_TILE_LAYER_PIXELS = 16LL * 1024 * 1024;
+
+//Static tile map pre-rendered into render target chunks
+class LTileLayer {
+public:
+    //Initializes variables
+    LTileLayer();
+
+    //Deallocates memory
+    ~LTileLayer();
+
+    //Bakes every tile into the chunk textures
+    bool bake(SDL_Renderer* mRenderer, const LTileMap& map);
+
+    //Re-bakes only the chunk holding given tile
+    void updateTile(SDL_Renderer* mRenderer, const LTileMap& map, int x, int y);
+
+    //Shows the part of the layer under the camera
+    void render(SDL_Renderer* mRenderer, LCamera& camera);
+
+    //Deallocates chunks
+    void free();
+
+    //Checks if the layer can be drawn
+    bool isBaked() const;
+
+private:
+    //Draws the tiles overlapping one chunk into its texture
+    void bakeChunk(SDL_Renderer* mRenderer, const LTileMap& map, int chunk);
+
+    //Gets a chunk's area in level space
+    SDL_Rect getChunkRect(int chunk) const;
+
+    //The chunk textures, row by row
+    std::vector<UniqueTexture> mChunks;
+
+    //Chunk dimensions
+    int mChunkWidth;
+    int mChunkHeight;
+
+    //Chunks per row and column
+    int mChunkColumns;
+    int mChunkRows;
+
+    //Level dimensions when baked
+    int mLevelWidth;
+    int mLevelHeight;
+};
+
+/*-------------------*
+LTileLayer functions
+---------------------*/
+
+//Initializes variables
+inline LTileLayer::LTileLayer() {
+    mChunkWidth = 0;
+    mChunkHeight = 0;
+    mChunkColumns = 0;
+    mChunkRows = 0;
+    mLevelWidth = 0;
+    mLevelHeight = 0;
+}
+
+//Deallocates memory
+inline LTileLayer::~LTileLayer() {
+    free();
+}
+
+//Bakes every tile into the chunk textures
+inline bool LTileLayer::bake(SDL_Renderer* mRenderer, const LTileMap& map) {
+    //Get rid of preexisting chunks
+    free();
+
+    if (!SDL_RenderTargetSupported(mRenderer)) {
+        printf("Warning: Render targets not supported, tiles will be drawn one by one!\n");
+        return false;
+    }
+
+    //Huge or streamed levels would not fit in video memory
+    if (map.isStreamed() || static_cast<long long>(map.getLevelWidth()) * map.getLevelHeight() > MAX_TILE_LAYER_PIXELS) {
+        printf("Warning: Level is too large to bake, visible tiles will be drawn one by one!\n");
+        return false;
+    }
+    mLevelWidth = map.getLevelWidth();
+    mLevelHeight = map.getLevelHeight();
+
+    //Respect the renderer's texture size limit, zero means unbounded
+    int maxWidth = MAX_TILE_CHUNK_SIZE, maxHeight = MAX_TILE_CHUNK_SIZE;
+    if (SDL_RendererInfo info; SDL_GetRendererInfo(mRenderer, &info) == 0) {
+        if (info.max_texture_width > 0) {
+            maxWidth = std::min(maxWidth, info.max_texture_width);
+        }
+        if (info.max_texture_height > 0) {
+            maxHeight = std::min(maxHeight, info.max_texture_height);
+        }
+    }
+
+    //Chunks hold whole tiles and never exceed the level
+    mChunkWidth = std::min(mLevelWidth, std::max(TILE_WIDTH, maxWidth / TILE_WIDTH * TILE_WIDTH));
+    mChunkHeight = std::min(mLevelHeight, std::max(TILE_HEIGHT, maxHeight / TILE_HEIGHT * TILE_HEIGHT));
+    mChunkColumns = (mLevelWidth + mChunkWidth - 1) / mChunkWidth;
+    mChunkRows = (mLevelHeight + mChunkHeight - 1) / mChunkHeight;
+
+    //Create and fill the chunks
+    mChunks.resize(mChunkColumns * mChunkRows);
+    for (int i = 0; i < static_cast<int>(mChunks.size()); ++i) {
+        const SDL_Rect area = getChunkRect(i);
+        mChunks[i].reset(SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, area.w, area.h));
+        if (mChunks[i] == nullptr) {
+            printf("Unable to create tile chunk texture! SDL Error: %s\n", SDL_GetError());
+            free();
+            return false;
+        }
+
+        //Chunks are opaque, copy them without blending
+        SDL_SetTextureBlendMode(mChunks[i].get(), SDL_BLENDMODE_NONE);
+        bakeChunk(mRenderer, map, i);
+    }
+
+    return true;
+}
+
+//Re-bakes only the chunk holding given tile
+inline void LTileLayer::updateTile(SDL_Renderer* mRenderer, const LTileMap& map, const int x, const int y) {
+    if (!isBaked()) {
+        return;
+    }
+
+    //Find chunk from the tile's position
+    const SDL_Rect box = map.getTileRect(x, y);
+    const int chunkColumn = box.x / mChunkWidth;
+    const int chunkRow = box.y / mChunkHeight;
+    bakeChunk(mRenderer, map, chunkRow * mChunkColumns + chunkColumn);
+}
+
+//Shows the part of the layer under the camera
+inline void LTileLayer::render(SDL_Renderer* mRenderer, LCamera& camera) {
+    //Chunks overlapped by the camera
+    const int firstColumn = std::max(0, camera.getX() / mChunkWidth);
+    const int lastColumn = std::min(mChunkColumns - 1, (camera.getX() + camera.getWidth() - 1) / mChunkWidth);
+    const int firstRow = std::max(0, camera.getY() / mChunkHeight);
+    const int lastRow = std::min(mChunkRows - 1, (camera.getY() + camera.getHeight() - 1) / mChunkHeight);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const SDL_Rect area = getChunkRect(row * mChunkColumns + column);
+
+            //Visible part of the chunk in level space
+            SDL_Rect visible;
+            if (!SDL_IntersectRect(&area, camera.getRect(), &visible)) {
+                continue;
+            }
+
+            //Copy it from chunk space to screen space
+            const SDL_Rect source = {visible.x - area.x, visible.y - area.y, visible.w, visible.h};
+            const SDL_Rect destination = {visible.x - camera.getX(), visible.y - camera.getY(), visible.w, visible.h};
+            gSpriteBatch.draw(mRenderer, mChunks[row * mChunkColumns + column].get(), source, destination);
+        }
+    }
+}
+
+//Deallocates chunks
+inline void LTileLayer::free() {
+    mChunks.clear();
+    mChunkColumns = 0;
+    mChunkRows = 0;
+}
+
+//Checks if the layer can be drawn
+inline bool LTileLayer::isBaked() const {
+    return !mChunks.empty();
+}
+
+//Draws the tiles overlapping one chunk into its texture
+inline void LTileLayer::bakeChunk(SDL_Renderer* mRenderer, const LTileMap& map, const int chunk) {
+    const SDL_Rect area = getChunkRect(chunk);
+
+    //Redirect drawing to the chunk
+    gSpriteBatch.flush();
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(mRenderer);
+    SDL_SetRenderTarget(mRenderer, mChunks[chunk].get());
+
+    //Fill with the window's clear color
+    SDL_SetRenderDrawColor(mRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+    SDL_RenderClear(mRenderer);
+
+    //Draw the tiles of the chunk
+    const int firstColumn = area.x / TILE_WIDTH;
+    const int lastColumn = std::min(map.getWidth(), (area.x + area.w + TILE_WIDTH - 1) / TILE_WIDTH);
+    const int firstRow = area.y / TILE_HEIGHT;
+    const int lastRow = std::min(map.getHeight(), (area.y + area.h + TILE_HEIGHT - 1) / TILE_HEIGHT);
+    for (int row = firstRow; row < lastRow; ++row) {
+        for (int column = firstColumn; column < lastColumn; ++column) {
+            gSpriteBatch.draw(mRenderer, gTileTexture, column * TILE_WIDTH - area.x, row * TILE_HEIGHT - area.y, &gTileClips[map.getTile(column, row)]);
+        }
+    }
+    gSpriteBatch.flush();
+
+    //Restore drawing to the previous target
+    SDL_SetRenderTarget(mRenderer, previousTarget);
+}
+
+//Gets a chunk's area in level space
+inline SDL_Rect LTileLayer::getChunkRect(const int chunk) const {
+    const int x = chunk % mChunkColumns * mChunkWidth;
+    const int y = chunk / mChunkColumns * mChunkHeight;
+    return {x, y, std::min(mChunkWidth, mLevelWidth - x), std::min(mChunkHeight, mLevelHeight - y)};
+}
+
+/*-----*
+Objects
+-------*/
+
+//Baked static tiles
+extern LTileLayer gTileLayer;
+
+#endif //LTILELAYER_H
@@ -0,0 +1,478 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LTILEMAP_H
+#define LTILEMAP_H
+#include <SDL.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "global.h"
+#include "LCamera.h"
+#include "LTextureAtlas.h"
+#include "LSpriteBatch.h"
+#include "LMapFile.h"
+
+//Tiles per side of a storage chunk
+inline constexpr int TILE_CHUNK_SIZE = 32;
+inline constexpr int TILES_PER_CHUNK = TILE_CHUNK_SIZE * TILE_CHUNK_SIZE;
+
+//Tile grid sized at load time, stored chunk by chunk so nearby tiles share cache lines
+class LTileMap {
+public:
+    //Initializes variables
+    LTileMap();
+
+    //Loads a binary .lmap or a text map, text map rows are as wide as the first line
+    bool loadFromFile(const std::string& path);
+
+    //Allocates an empty map of given size in tiles
+    void create(int width, int height);
+
+    //Allocates a map whose chunks are loaded and unloaded at runtime, at most residentChunks at once
+    void createStreamed(int width, int height, int residentChunks);
+
+    //Deallocates tiles
+    void free();
+
+    //Gets and sets tile types, positions are in tiles, tiles of unloaded chunks read as -1
+    int getTile(int x, int y) const;
+    void setTile(int x, int y, int tileType);
+
+    //Checks if a tile blocks movement, unloaded chunks are solid
+    bool isWall(int x, int y) const;
+
+    //Gets a tile's area in level space
+    SDL_Rect getTileRect(int x, int y) const;
+
+    //Gets a storage chunk's tiles row by row, nullptr while it is not resident
+    const Uint16* getChunk(int chunk) const;
+
+    //Copies a chunk's tiles in, fails when every resident slot is taken
+    bool loadChunk(int chunk, const Uint16* tiles);
+
+    //Releases a chunk's slot
+    void unloadChunk(int chunk);
+
+    //Checks chunk residency
+    bool isChunkLoaded(int chunk) const;
+    bool isStreamed() const;
+
+    //Shows the tiles under the camera, only visible chunks are touched
+    void render(SDL_Renderer* mRenderer, LCamera& camera) const;
+
+    //Gets map dimensions in tiles
+    int getWidth() const;
+    int getHeight() const;
+
+    //Gets level dimensions in pixels
+    int getLevelWidth() const;
+    int getLevelHeight() const;
+
+    //Gets storage chunk counts
+    int getChunkColumns() const;
+    int getChunkRows() const;
+
+private:
+    //Loads tile ids straight out of a binary map
+    bool loadFromMapFile(const std::string& path);
+
+    //Parses a whitespace separated text map
+    bool loadFromTextFile(const std::string& path);
+
+    //Gets where a tile is stored, -1 when its chunk is not resident
+    int getIndex(int x, int y) const;
+
+    //Resident chunks' tiles back to back, edge chunks padded
+    std::vector<Uint16> mTiles;
+
+    //Slot of every chunk in the tiles, -1 while it is not resident
+    std::vector<int> mChunkSlots;
+
+    //Slots not holding a chunk
+    std::vector<int> mFreeSlots;
+
+    //Whether chunks come and go at runtime
+    bool mStreamed;
+
+    //Map dimensions in tiles
+    int mWidth;
+    int mHeight;
+
+    //Chunks per row and column
+    int mChunkColumns;
+    int mChunkRows;
+};
+
+//Clips the tile sprite sheet
+void setTileClips();
+
+/*-----------------*
+LTileMap functions
+-------------------*/
+
+//Initializes variables
+inline LTileMap::LTileMap() {
+    mWidth = 0;
+    mHeight = 0;
+    mChunkColumns = 0;
+    mChunkRows = 0;
+    mStreamed = false;
+}
+
+//Loads a binary .lmap or a text map
+inline bool LTileMap::loadFromFile(const std::string& path) {
+    //Get rid of preexisting map
+    free();
+
+    //Binary maps skip parsing entirely
+    const bool success = path.ends_with(".lmap") ? loadFromMapFile(path) : loadFromTextFile(path);
+    if (!success) {
+        free();
+    }
+
+    return success;
+}
+
+//Allocates an empty map of given size in tiles
+inline void LTileMap::create(const int width, const int height) {
+    mWidth = width;
+    mHeight = height;
+    mChunkColumns = (width + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    mChunkRows = (height + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    mTiles.assign(static_cast<size_t>(mChunkColumns) * mChunkRows * TILES_PER_CHUNK, TILE_RED);
+
+    //Every chunk is resident in its own slot
+    mChunkSlots.resize(mChunkColumns * mChunkRows);
+    for (int i = 0; i < static_cast<int>(mChunkSlots.size()); ++i) {
+        mChunkSlots[i] = i;
+    }
+    mFreeSlots.clear();
+    mStreamed = false;
+}
+
+//Allocates a map whose chunks are loaded and unloaded at runtime
+inline void LTileMap::createStreamed(const int width, const int height, const int residentChunks) {
+    mWidth = width;
+    mHeight = height;
+    mChunkColumns = (width + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    mChunkRows = (height + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    mTiles.assign(static_cast<size_t>(residentChunks) * TILES_PER_CHUNK, TILE_RED);
+
+    //Nothing is resident yet, lowest slots are handed out first
+    mChunkSlots.assign(mChunkColumns * mChunkRows, -1);
+    mFreeSlots.resize(residentChunks);
+    for (int i = 0; i < residentChunks; ++i) {
+        mFreeSlots[i] = residentChunks - 1 - i;
+    }
+    mStreamed = true;
+}
+
+//Deallocates tiles
+inline void LTileMap::free() {
+    mTiles.clear();
+    mTiles.shrink_to_fit();
+    mChunkSlots.clear();
+    mFreeSlots.clear();
+    mStreamed = false;
+    mWidth = 0;
+    mHeight = 0;
+    mChunkColumns = 0;
+    mChunkRows = 0;
+}
+
+//Gets and sets tile types
+inline int LTileMap::getTile(const int x, const int y) const {
+    const int index = getIndex(x, y);
+    return index < 0 ? -1 : mTiles[index];
+}
+
+inline void LTileMap::setTile(const int x, const int y, const int tileType) {
+    if (const int index = getIndex(x, y); index >= 0) {
+        mTiles[index] = static_cast<Uint16>(tileType);
+    }
+}
+
+//Checks if a tile blocks movement
+inline bool LTileMap::isWall(const int x, const int y) const {
+    const int tileType = getTile(x, y);
+    return tileType < 0 || (tileType >= TILE_CENTER && tileType <= TILE_TOPLEFT);
+}
+
+//Gets a tile's area in level space
+inline SDL_Rect LTileMap::getTileRect(const int x, const int y) const {
+    return {x * TILE_WIDTH, y * TILE_HEIGHT, TILE_WIDTH, TILE_HEIGHT};
+}
+
+//Gets a storage chunk's tiles
+inline const Uint16* LTileMap::getChunk(const int chunk) const {
+    const int slot = mChunkSlots[chunk];
+    return slot < 0 ? nullptr : &mTiles[static_cast<size_t>(slot) * TILES_PER_CHUNK];
+}
+
+//Copies a chunk's tiles in, fails when every resident slot is taken
+inline bool LTileMap::loadChunk(const int chunk, const Uint16* tiles) {
+    //Take a free slot unless already resident
+    if (mChunkSlots[chunk] < 0) {
+        if (mFreeSlots.empty()) {
+            return false;
+        }
+        mChunkSlots[chunk] = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    }
+
+    std::copy(tiles, tiles + TILES_PER_CHUNK, &mTiles[static_cast<size_t>(mChunkSlots[chunk]) * TILES_PER_CHUNK]);
+    return true;
+}
+
+//Releases a chunk's slot
+inline void LTileMap::unloadChunk(const int chunk) {
+    if (mChunkSlots[chunk] >= 0) {
+        mFreeSlots.push_back(mChunkSlots[chunk]);
+        mChunkSlots[chunk] = -1;
+    }
+}
+
+//Checks chunk residency
+inline bool LTileMap::isChunkLoaded(const int chunk) const {
+    return mChunkSlots[chunk] >= 0;
+}
+
+inline bool LTileMap::isStreamed() const {
+    return mStreamed;
+}
+
+//Shows the tiles under the camera
+inline void LTileMap::render(SDL_Renderer* mRenderer, LCamera& camera) const {
+    //Tiles overlapped by the camera
+    const int firstColumn = std::max(0, camera.getX() / TILE_WIDTH);
+    const int lastColumn = std::min(mWidth - 1, (camera.getX() + camera.getWidth() - 1) / TILE_WIDTH);
+    const int firstRow = std::max(0, camera.getY() / TILE_HEIGHT);
+    const int lastRow = std::min(mHeight - 1, (camera.getY() + camera.getHeight() - 1) / TILE_HEIGHT);
+
+    //Walk the visible chunks, then the visible tiles inside each
+    for (int chunkRow = firstRow / TILE_CHUNK_SIZE; chunkRow <= lastRow / TILE_CHUNK_SIZE; ++chunkRow) {
+        for (int chunkColumn = firstColumn / TILE_CHUNK_SIZE; chunkColumn <= lastColumn / TILE_CHUNK_SIZE; ++chunkColumn) {
+            //Chunks still streaming in are skipped
+            const Uint16* chunk = getChunk(chunkRow * mChunkColumns + chunkColumn);
+            if (chunk == nullptr) {
+                continue;
+            }
+            const int originX = chunkColumn * TILE_CHUNK_SIZE;
+            const int originY = chunkRow * TILE_CHUNK_SIZE;
+            for (int y = std::max(firstRow, originY); y <= std::min(lastRow, originY + TILE_CHUNK_SIZE - 1); ++y) {
+                for (int x = std::max(firstColumn, originX); x <= std::min(lastColumn, originX + TILE_CHUNK_SIZE - 1); ++x) {
+                    const int tileType = chunk[(y - originY) * TILE_CHUNK_SIZE + x - originX];
+                    gSpriteBatch.draw(mRenderer, gTileTexture, x * TILE_WIDTH - camera.getX(), y * TILE_HEIGHT - camera.getY(), &gTileClips[tileType]);
+                }
+            }
+        }
+    }
+}
+
+//Gets map dimensions in tiles
+inline int LTileMap::getWidth() const {
+    return mWidth;
+}
+
+inline int LTileMap::getHeight() const {
+    return mHeight;
+}
+
+//Gets level dimensions in pixels
+inline int LTileMap::getLevelWidth() const {
+    return mWidth * TILE_WIDTH;
+}
+
+inline int LTileMap::getLevelHeight() const {
+    return mHeight * TILE_HEIGHT;
+}
+
+//Gets storage chunk counts
+inline int LTileMap::getChunkColumns() const {
+    return mChunkColumns;
+}
+
+inline int LTileMap::getChunkRows() const {
+    return mChunkRows;
+}
+
+//Loads tile ids straight out of a binary map
+inline bool LTileMap::loadFromMapFile(const std::string& path) {
+    //Map the file
+    LMapFile map;
+    if (!map.open(path)) {
+        return false;
+    }
+
+    //Tiles are drawn with the sprite sheet's clips
+    if (map.getTileWidth() != TILE_WIDTH || map.getTileHeight() != TILE_HEIGHT) {
+        printf("Error loading map: %s has %dx%d tiles, expected %dx%d!\n", path.c_str(), map.getTileWidth(), map.getTileHeight(), TILE_WIDTH, TILE_HEIGHT);
+        return false;
+    }
+    create(map.getWidth(), map.getHeight());
+
+    //Tile ids of an encoded chunk
+    const int fileChunkSize = map.getChunkSize();
+    std::vector<Uint16> decoded(static_cast<size_t>(fileChunkSize) * fileChunkSize);
+
+    //Copy the file's chunks into ours
+    for (int chunk = 0; chunk < map.getChunkColumns() * map.getChunkRows(); ++chunk) {
+        const uint8_t* raw = map.getRawChunk(0, chunk);
+        if (raw == nullptr && !map.readChunk(0, chunk, decoded.data())) {
+            printf("Error loading map: Corrupt chunk %d!\n", chunk);
+            return false;
+        }
+
+        const int originX = chunk % map.getChunkColumns() * fileChunkSize;
+        const int originY = chunk / map.getChunkColumns() * fileChunkSize;
+        const int columns = std::min(fileChunkSize, mWidth - originX);
+        const int rows = std::min(fileChunkSize, mHeight - originY);
+        for (int y = 0; y < rows; ++y) {
+            //Tiles of a file row land in one chunk row when chunk sizes match
+            Uint16* destination = fileChunkSize == TILE_CHUNK_SIZE ? &mTiles[getIndex(originX, originY + y)] : nullptr;
+            for (int x = 0; x < columns; ++x) {
+                const int index = y * fileChunkSize + x;
+                int tileType = decoded[index];
+                if (raw != nullptr) {
+                    tileType = map.getBytesPerTile() == 1 ? raw[index] : raw[2 * index] | raw[2 * index + 1] << 8;
+                }
+
+                //If we don't recognize the tile type
+                if (tileType >= TOTAL_TILE_SPRITES) {
+                    printf("Error loading map: Invalid tile at %d, %d!\n", originX + x, originY + y);
+                    return false;
+                }
+
+                if (destination != nullptr) {
+                    destination[x] = static_cast<Uint16>(tileType);
+                }
+                else {
+                    setTile(originX + x, originY + y, tileType);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+//Parses a whitespace separated text map
+inline bool LTileMap::loadFromTextFile(const std::string& path) {
+    //Open the map
+    std::ifstream map(path.c_str());
+
+    //If the map couldn't be loaded
+    if (map.fail()) {
+        printf("Unable to load map file %s!\n", path.c_str());
+        return false;
+    }
+
+    //Rows are as wide as the first line
+    std::string line;
+    std::getline(map, line);
+    std::istringstream firstRow(line);
+
+    //Read every tile
+    std::vector<int> tiles;
+    int width = 0;
+    for (int tileType; firstRow >> tileType; ++width) {
+        tiles.push_back(tileType);
+    }
+    for (int tileType; map >> tileType;) {
+        tiles.push_back(tileType);
+    }
+
+    //If there was a problem in read the map, reading stops at anything that is not a number so both must reach their end
+    if (width == 0 || !firstRow.eof() || !map.eof() || tiles.size() % width != 0) {
+        printf("Unable to load map file %s!\n", path.c_str());
+        return false;
+    }
+
+    //Lay the tiles out in chunks
+    create(width, static_cast<int>(tiles.size() / width));
+    for (int i = 0; i < static_cast<int>(tiles.size()); ++i) {
+        //If we don't recognize the tile type
+        if (tiles[i] < 0 || tiles[i] >= TOTAL_TILE_SPRITES) {
+            printf("Error loading map: Invalid tile at %d!\n", i);
+            return false;
+        }
+        setTile(i % width, i / width, tiles[i]);
+    }
+
+    return true;
+}
+
+//Gets where a tile is stored
+inline int LTileMap::getIndex(const int x, const int y) const {
+    const int slot = mChunkSlots[y / TILE_CHUNK_SIZE * mChunkColumns + x / TILE_CHUNK_SIZE];
+    return slot < 0 ? -1 : slot * TILES_PER_CHUNK + y % TILE_CHUNK_SIZE * TILE_CHUNK_SIZE + x % TILE_CHUNK_SIZE;
+}
+
+/*-----------*
+Sprite sheet
+-------------*/
+
+//Clips the tile sprite sheet
+inline void setTileClips() {
+    gTileClips[ TILE_RED ].x = 0;
+    gTileClips[ TILE_RED ].y = 0;
+    gTileClips[ TILE_RED ].w = TILE_WIDTH;
+    gTileClips[ TILE_RED ].h = TILE_HEIGHT;
+    gTileClips[ TILE_GREEN ].x = 0;
+    gTileClips[ TILE_GREEN ].y = 80;
+    gTileClips[ TILE_GREEN ].w = TILE_WIDTH;
+    gTileClips[ TILE_GREEN ].h = TILE_HEIGHT;
+    gTileClips[ TILE_BLUE ].x = 0;
+    gTileClips[ TILE_BLUE ].y = 160;
+    gTileClips[ TILE_BLUE ].w = TILE_WIDTH;
+    gTileClips[ TILE_BLUE ].h = TILE_HEIGHT;
+    gTileClips[ TILE_TOPLEFT ].x = 80;
+    gTileClips[ TILE_TOPLEFT ].y = 0;
+    gTileClips[ TILE_TOPLEFT ].w = TILE_WIDTH;
+    gTileClips[ TILE_TOPLEFT ].h = TILE_HEIGHT;
+    gTileClips[ TILE_LEFT ].x = 80;
+    gTileClips[ TILE_LEFT ].y = 80;
+    gTileClips[ TILE_LEFT ].w = TILE_WIDTH;
+    gTileClips[ TILE_LEFT ].h = TILE_HEIGHT;
+    gTileClips[ TILE_BOTTOMLEFT ].x = 80;
+    gTileClips[ TILE_BOTTOMLEFT ].y = 160;
+    gTileClips[ TILE_BOTTOMLEFT ].w = TILE_WIDTH;
+    gTileClips[ TILE_BOTTOMLEFT ].h = TILE_HEIGHT;
+    gTileClips[ TILE_TOP ].x = 160;
+    gTileClips[ TILE_TOP ].y = 0;
+    gTileClips[ TILE_TOP ].w = TILE_WIDTH;
+    gTileClips[ TILE_TOP ].h = TILE_HEIGHT;
+    gTileClips[ TILE_CENTER ].x = 160;
+    gTileClips[ TILE_CENTER ].y = 80;
+    gTileClips[ TILE_CENTER ].w = TILE_WIDTH;
+    gTileClips[ TILE_CENTER ].h = TILE_HEIGHT;
+    gTileClips[ TILE_BOTTOM ].x = 160;
+    gTileClips[ TILE_BOTTOM ].y = 160;
+    gTileClips[ TILE_BOTTOM ].w = TILE_WIDTH;
+    gTileClips[ TILE_BOTTOM ].h = TILE_HEIGHT;
+    gTileClips[ TILE_TOPRIGHT ].x = 240;
+    gTileClips[ TILE_TOPRIGHT ].y = 0;
+    gTileClips[ TILE_TOPRIGHT ].w = TILE_WIDTH;
+    gTileClips[ TILE_TOPRIGHT ].h = TILE_HEIGHT;
+    gTileClips[ TILE_RIGHT ].x = 240;
+    gTileClips[ TILE_RIGHT ].y = 80;
+    gTileClips[ TILE_RIGHT ].w = TILE_WIDTH;
+    gTileClips[ TILE_RIGHT ].h = TILE_HEIGHT;
+    gTileClips[ TILE_BOTTOMRIGHT ].x = 240;
+    gTileClips[ TILE_BOTTOMRIGHT ].y = 160;
+    gTileClips[ TILE_BOTTOMRIGHT ].w = TILE_WIDTH;
+    gTileClips[ TILE_BOTTOMRIGHT ].h = TILE_HEIGHT;
+}
+
+/*-----*
+Objects
+-------*/
+
+//The level's tiles
+extern LTileMap gTileMap;
+
+#endif //LTILEMAP_H
@@ -6,15 +6,27 @@
 #define LWINDOW_H
 #include <SDL.h>
 #include <sstream>
+#include <utility>
+#include "LProfiler.h"
+#include "SDLDeleter.h"
 
 extern int gTotalDisplays;
 extern SDL_Rect* gDisplayBounds;
 
+//Window and its renderer, owned so it moves but never copies
 class LWindow {
 public:
     //Initializes internals
     LWindow();
 
+    //Takes over another window and its renderer
+    LWindow(LWindow&& other) noexcept;
+    LWindow& operator=(LWindow&& other) noexcept;
+
+    //Two owners would destroy the window twice
+    LWindow(const LWindow&) = delete;
+    LWindow& operator=(const LWindow&) = delete;
+
     //Creates window
     bool init(int windowWidth, int windowHeight);
 
@@ -40,15 +52,18 @@ public:
     //Window's renderer
     SDL_Renderer* getRenderer();
 
+    //Window's ID, events carry it
+    Uint32 getWindowID();
+
     //window focii
     bool hasMouseFocus();
     bool hasKeyboardFocus();
     bool isMinimized();
     bool isShown();
 private:
-    //Window data
-    SDL_Window* mWindow;
-    SDL_Renderer* mRenderer;
+    //Window data, the renderer is declared last so it is destroyed first
+    UniqueWindow mWindow;
+    UniqueRenderer mRenderer;
     int mWindowID;
     int mWindowDisplayID;
 
@@ -83,9 +98,41 @@ inline LWindow::LWindow() {
     mHeight = 0;
 }
 
+inline LWindow::LWindow(LWindow&& other) noexcept {
+    //Start empty, then swap in the other window
+    mMouseFocus = false;
+    mKeyboardFocus = false;
+    mFullscreen = false;
+    mMinimized = false;
+    mShown = false;
+    mWindowID = 0;
+    mWindowDisplayID = 0;
+    mWidth = 0;
+    mHeight = 0;
+    *this = std::move(other);
+}
+
+inline LWindow& LWindow::operator=(LWindow&& other) noexcept {
+    if (this != &other) {
+        //Renderer before window, like free
+        mRenderer = std::move(other.mRenderer);
+        mWindow = std::move(other.mWindow);
+        mWindowID = std::exchange(other.mWindowID, 0);
+        mWindowDisplayID = std::exchange(other.mWindowDisplayID, 0);
+        mWidth = std::exchange(other.mWidth, 0);
+        mHeight = std::exchange(other.mHeight, 0);
+        mMouseFocus = std::exchange(other.mMouseFocus, false);
+        mKeyboardFocus = std::exchange(other.mKeyboardFocus, false);
+        mFullscreen = std::exchange(other.mFullscreen, false);
+        mMinimized = std::exchange(other.mMinimized, false);
+        mShown = std::exchange(other.mShown, false);
+    }
+    return *this;
+}
+
 inline bool LWindow::init(const int windowWidth, const int windowHeight) {
     //Create window
-    mWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, windowWidth, windowHeight, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+    mWindow.reset(SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, windowWidth, windowHeight, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE));
     if (mWindow != nullptr) {
         mMouseFocus = true;
         mKeyboardFocus = true;
@@ -93,19 +140,18 @@ inline bool LWindow::init(const int windowWidth, const int windowHeight) {
         mHeight = windowHeight;
 
         //Create renderer for window
-        mRenderer = SDL_CreateRenderer(mWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        mRenderer.reset(SDL_CreateRenderer(mWindow.get(), -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC));
         if (mRenderer == nullptr) {
             printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
-            SDL_DestroyWindow(mWindow);
-            mWindow = nullptr;
+            mWindow.reset();
         }
         else {
             //Initialize renderer color
-            SDL_SetRenderDrawColor(mRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+            SDL_SetRenderDrawColor(mRenderer.get(), 0xFF, 0xFF, 0xFF, 0xFF);
 
             //Grab window identifiers
-            mWindowID = SDL_GetWindowID(mWindow);
-            mWindowDisplayID = SDL_GetWindowDisplayIndex(mWindow);
+            mWindowID = SDL_GetWindowID(mWindow.get());
+            mWindowDisplayID = SDL_GetWindowDisplayIndex(mWindow.get());
 
             //Flag as opened
             mShown = true;
@@ -127,7 +173,7 @@ inline void LWindow::handleEvent(const SDL_Event& e) {
         switch (e.window.event) {
             //Window moved
             case SDL_WINDOWEVENT_MOVED:
-                mWindowDisplayID = SDL_GetWindowDisplayIndex(mWindow);
+                mWindowDisplayID = SDL_GetWindowDisplayIndex(mWindow.get());
                 updateCaption = true;
                 break;
             //Window appeared
@@ -142,11 +188,11 @@ inline void LWindow::handleEvent(const SDL_Event& e) {
             case SDL_WINDOWEVENT_SIZE_CHANGED:
                 mWidth = e.window.data1;
                 mHeight = e.window.data2;
-                SDL_RenderPresent(mRenderer);
+                SDL_RenderPresent(mRenderer.get());
                 break;
             //Repaint on exposure
             case SDL_WINDOWEVENT_EXPOSED:
-                SDL_RenderPresent(mRenderer);
+                SDL_RenderPresent(mRenderer.get());
                 break;
             //Mouse entered window
             case SDL_WINDOWEVENT_ENTER:
@@ -182,7 +228,7 @@ inline void LWindow::handleEvent(const SDL_Event& e) {
                 break;
             //Hide on close
             case SDL_WINDOWEVENT_CLOSE:
-                SDL_HideWindow(mWindow);
+                SDL_HideWindow(mWindow.get());
                 break;
         }
     }
@@ -194,11 +240,11 @@ inline void LWindow::handleEvent(const SDL_Event& e) {
         switch (e.key.keysym.sym) {
             case SDLK_RETURN:
                 if (mFullscreen) {
-                    SDL_SetWindowFullscreen(mWindow, 0);
+                    SDL_SetWindowFullscreen(mWindow.get(), 0);
                     mFullscreen = false;
                 }
                 else {
-                    SDL_SetWindowFullscreen(mWindow, SDL_WINDOW_FULLSCREEN_DESKTOP);
+                    SDL_SetWindowFullscreen(mWindow.get(), SDL_WINDOW_FULLSCREEN_DESKTOP);
                     mFullscreen = true;
                     mMinimized = false;
                 }
@@ -222,7 +268,7 @@ inline void LWindow::handleEvent(const SDL_Event& e) {
                 mWindowDisplayID = 0;
             }
             //Move window to center of next display
-            SDL_SetWindowPosition(mWindow, gDisplayBounds[mWindowDisplayID].x + (gDisplayBounds[mWindowDisplayID].w - mWidth) / 2, gDisplayBounds[mWindowDisplayID].y + (gDisplayBounds[mWindowDisplayID].h - mHeight) / 2);
+            SDL_SetWindowPosition(mWindow.get(), gDisplayBounds[mWindowDisplayID].x + (gDisplayBounds[mWindowDisplayID].w - mWidth) / 2, gDisplayBounds[mWindowDisplayID].y + (gDisplayBounds[mWindowDisplayID].h - mHeight) / 2);
             updateCaption = true;
         }
     }
@@ -230,43 +276,40 @@ inline void LWindow::handleEvent(const SDL_Event& e) {
     if (updateCaption) {
         std::stringstream caption;
         caption << "SDL Tutorial - ID: " << mWindowID << " Display: " << mWindowDisplayID << " MouseFocus: " << ((mMouseFocus) ? "On" : "Off") << " KeyboardFocus: " << ((mKeyboardFocus) ? "On" : "Off");
-        SDL_SetWindowTitle(mWindow, caption.str().c_str());
+        SDL_SetWindowTitle(mWindow.get(), caption.str().c_str());
     }
 }
 
 inline void LWindow::focus() {
     //Restore window if needed
     if (!mShown) {
-        SDL_ShowWindow(mWindow);
+        SDL_ShowWindow(mWindow.get());
     }
     //Move window forward
-    SDL_RaiseWindow(mWindow);
+    SDL_RaiseWindow(mWindow.get());
 }
 
 inline void LWindow::clear() {
     if (!mMinimized) {
         //Clear screen
-        SDL_SetRenderDrawColor(mRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
-        SDL_RenderClear(mRenderer);
+        SDL_SetRenderDrawColor(mRenderer.get(), 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(mRenderer.get());
     }
 }
 
 inline void LWindow::render() {
     if (!mMinimized) {
+        PROFILE_ZONE("SDL_RenderPresent");
+
         //Update screen
-        SDL_RenderPresent(mRenderer);
+        SDL_RenderPresent(mRenderer.get());
     }
 }
 
 inline void LWindow::free() {
-    if (mWindow != nullptr) {
-        SDL_DestroyWindow(mWindow);
-        mWindow = nullptr;
-    }
-    if (mRenderer != nullptr) {
-        SDL_DestroyRenderer(mRenderer);
-        mRenderer = nullptr;
-    }
+    //The renderer goes before the window it draws to
+    mRenderer.reset();
+    mWindow.reset();
 }
 
 inline int LWindow::getWidth() {
@@ -278,7 +321,11 @@ inline int LWindow::getHeight() {
 }
 
 inline SDL_Renderer* LWindow::getRenderer() {
-    return mRenderer;
+    return mRenderer.get();
+}
+
+inline Uint32 LWindow::getWindowID() {
+    return static_cast<Uint32>(mWindowID);
 }
 
 inline bool LWindow::hasMouseFocus() {
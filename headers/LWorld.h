@@ -0,0 +1,451 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef LWORLD_H
+#define LWORLD_H
+#include <SDL.h>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <random>
+#include <vector>
+#include "Circle.h"
+#include "collisionDetection.h"
+#include "collisionKernel.h"
+#include "DeltaTime.h"
+#include "LCamera.h"
+#include "LJobSystem.h"
+#include "LParticle.h"
+#include "LProfiler.h"
+#include "LSpatialHash.h"
+#include "LStateHash.h"
+#include "LSpriteBatch.h"
+#include "LTextureAtlas.h"
+#include "LTileMap.h"
+
+//Agents spawned with the level unless told otherwise
+inline constexpr int TOTAL_AGENTS = 1000;
+
+//Agent speed in pixels per second and collision radius
+inline constexpr float AGENT_SPEED = 120.f;
+inline constexpr int AGENT_RADIUS = 10;
+
+//Particles trailing each agent, agents spawned once the pool is full go without
+inline constexpr int AGENT_PARTICLES = 4;
+
+//Spawning is seeded so every run starts the same
+inline constexpr unsigned AGENT_SEED = 1234;
+
+//Entities handed to one job, large enough to outweigh scheduling
+inline constexpr int ENTITY_JOB_GRAIN = 1024;
+
+//Optional components an entity may have, position and velocity are always there
+enum ComponentFlags {
+    COMPONENT_COLLIDER = 1 << 0,
+    COMPONENT_SPRITE = 1 << 1,
+    COMPONENT_EMITTER = 1 << 2
+};
+
+//Entities stored as one contiguous array per component, systems walk them linearly in parallel ranges
+class LWorld {
+public:
+    //Initializes variables
+    LWorld();
+
+    //Adds an entity with a position and velocity, returns its index
+    int createEntity(float x, float y, float velX, float velY);
+
+    //Gives an entity a collision circle
+    void setCollider(int entity, int radius);
+
+    //Gives an entity a sprite, drawn centered on its position
+    void setSprite(int entity, const LTextureRegion& sprite);
+
+    //Gives an entity a particle trail, false when the pool is full
+    bool setEmitter(int entity, int particles);
+
+    //Scatters agents heading in random directions over open floor, none on streamed levels
+    int spawnAgents(int count, const LTileMap& map, const LTextureRegion& sprite);
+
+    //Movement system, advances every entity by its velocity
+    LJob* move(LJobSystem& jobs, float delta, std::initializer_list<LJob*> dependencies = {});
+
+    //Collision system, sweeps each move axis by axis, stopping at walls and bouncing off, the map must outlive the job
+    LJob* collide(LJobSystem& jobs, const LTileMap& map, std::initializer_list<LJob*> dependencies = {});
+
+    //Contact system, finds colliders touching each other and bounces them apart, one job since pairs share entities
+    LJob* collideEntities(LJobSystem& jobs, std::initializer_list<LJob*> dependencies = {});
+
+    //Particle system, respawns and ages every trail
+    LJob* updateParticles(LJobSystem& jobs, std::initializer_list<LJob*> dependencies = {});
+
+    //Render system, draws trails and sprites inside the camera
+    void render(SDL_Renderer* mRenderer, LCamera& camera);
+
+    //Removes every entity
+    void free();
+
+    //Gets number of entities
+    int getCount() const;
+
+    //Mixes every position and velocity into a hash, entities move in floats so it only matches within one build
+    void hashState(LStateHash& hash) const;
+
+private:
+    //Checks if a circle leaves the level or touches a wall
+    static bool isBlocked(const Circle& circle, const LTileMap& map);
+
+    //The systems over a range of entities
+    void moveRange(int begin, int end, float delta);
+    void collideRange(int begin, int end, const LTileMap& map);
+    void updateParticlesRange(int begin, int end);
+
+    //Bounces apart every pair of touching colliders
+    void resolveContacts();
+
+    //Bounces two touching entities off each other
+    void bounce(int a, int b);
+
+    //Position, and position before the last move for interpolated rendering
+    std::vector<float> mPosX, mPosY;
+    std::vector<float> mPrevPosX, mPrevPosY;
+
+    //Velocity in pixels per second
+    std::vector<float> mVelX, mVelY;
+
+    //Which optional components each entity has
+    std::vector<Uint8> mComponents;
+
+    //Collider radius
+    std::vector<int> mRadius;
+
+    //Index into the distinct sprites
+    std::vector<Uint16> mSprite;
+
+    //First particle slot and number of slots
+    std::vector<int> mEmitterFirst;
+    std::vector<Uint8> mEmitterCount;
+
+    //Distinct sprites, entities share them by index
+    std::vector<LTextureRegion> mSprites;
+
+    //Broadphase rebuilt every tick and the pairs it found, kept to reuse their memory
+    LSpatialHash mContacts;
+    std::vector<LCollisionPair> mPairs;
+
+    //Number of entities
+    int mCount;
+};
+
+/*--------------*
+LWorld functions
+----------------*/
+
+//Initializes variables
+inline LWorld::LWorld() {
+    mCount = 0;
+}
+
+//Adds an entity with a position and velocity
+inline int LWorld::createEntity(const float x, const float y, const float velX, const float velY) {
+    mPosX.push_back(x);
+    mPosY.push_back(y);
+    mPrevPosX.push_back(x);
+    mPrevPosY.push_back(y);
+    mVelX.push_back(velX);
+    mVelY.push_back(velY);
+    mComponents.push_back(0);
+    mRadius.push_back(0);
+    mSprite.push_back(0);
+    mEmitterFirst.push_back(-1);
+    mEmitterCount.push_back(0);
+    return mCount++;
+}
+
+//Gives an entity a collision circle
+inline void LWorld::setCollider(const int entity, const int radius) {
+    mRadius[entity] = radius;
+    mComponents[entity] |= COMPONENT_COLLIDER;
+}
+
+//Gives an entity a sprite
+inline void LWorld::setSprite(const int entity, const LTextureRegion& sprite) {
+    //Share an existing sprite if it shows the same image
+    int index = 0;
+    while (index < static_cast<int>(mSprites.size())) {
+        const SDL_Rect a = mSprites[index].getSource(), b = sprite.getSource();
+        if (mSprites[index].getTexture() == sprite.getTexture() && SDL_RectEquals(&a, &b)) {
+            break;
+        }
+        ++index;
+    }
+    if (index == static_cast<int>(mSprites.size())) {
+        mSprites.push_back(sprite);
+    }
+
+    mSprite[entity] = static_cast<Uint16>(index);
+    mComponents[entity] |= COMPONENT_SPRITE;
+}
+
+//Gives an entity a particle trail
+inline bool LWorld::setEmitter(const int entity, const int particles) {
+    if (gParticlePool.getUsed() + particles > gParticlePool.getCapacity()) {
+        return false;
+    }
+    mEmitterFirst[entity] = gParticlePool.addEmitter(particles);
+    mEmitterCount[entity] = static_cast<Uint8>(particles);
+    mComponents[entity] |= COMPONENT_EMITTER;
+    return true;
+}
+
+//Scatters agents over open floor
+inline int LWorld::spawnAgents(const int count, const LTileMap& map, const LTextureRegion& sprite) {
+    if (map.getWidth() == 0 || map.getHeight() == 0) {
+        return 0;
+    }
+
+    //Chunks of streamed levels come and go with the camera and read as walls while away, agents would
+    //bunch up in the resident window and bounce off its edges depending on when the streamer finished
+    if (map.isStreamed()) {
+        printf("Agents are not spawned on streamed levels\n");
+        return 0;
+    }
+
+    //Grow every array once
+    for (auto* component : {&mPosX, &mPosY, &mPrevPosX, &mPrevPosY, &mVelX, &mVelY}) {
+        component->reserve(mCount + count);
+    }
+    mComponents.reserve(mCount + count);
+    mRadius.reserve(mCount + count);
+    mSprite.reserve(mCount + count);
+    mEmitterFirst.reserve(mCount + count);
+    mEmitterCount.reserve(mCount + count);
+
+    std::mt19937 random(AGENT_SEED + mCount);
+    std::uniform_real_distribution<float> x(AGENT_RADIUS, map.getLevelWidth() - AGENT_RADIUS);
+    std::uniform_real_distribution<float> y(AGENT_RADIUS, map.getLevelHeight() - AGENT_RADIUS);
+    std::uniform_real_distribution<float> angle(0.f, 2.f * std::numbers::pi_v<float>);
+
+    int spawned = 0;
+    for (int i = 0; i < count; ++i) {
+        //Look for a free spot a few times, crowded levels get fewer agents
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            const float posX = x(random), posY = y(random);
+            if (isBlocked({static_cast<int>(posX), static_cast<int>(posY), AGENT_RADIUS}, map)) {
+                continue;
+            }
+
+            const float heading = angle(random);
+            const int entity = createEntity(posX, posY, AGENT_SPEED * std::cos(heading), AGENT_SPEED * std::sin(heading));
+            setCollider(entity, AGENT_RADIUS);
+            setSprite(entity, sprite);
+            setEmitter(entity, AGENT_PARTICLES);
+            ++spawned;
+            break;
+        }
+    }
+
+    return spawned;
+}
+
+//Movement system
+inline LJob* LWorld::move(LJobSystem& jobs, const float delta, const std::initializer_list<LJob*> dependencies) {
+    return jobs.parallelFor(mCount, ENTITY_JOB_GRAIN, [this, delta](const int begin, const int end) {
+        moveRange(begin, end, delta);
+    }, dependencies);
+}
+
+//Collision system
+inline LJob* LWorld::collide(LJobSystem& jobs, const LTileMap& map, const std::initializer_list<LJob*> dependencies) {
+    return jobs.parallelFor(mCount, ENTITY_JOB_GRAIN, [this, &map](const int begin, const int end) {
+        collideRange(begin, end, map);
+    }, dependencies);
+}
+
+//Contact system
+inline LJob* LWorld::collideEntities(LJobSystem& jobs, const std::initializer_list<LJob*> dependencies) {
+    return jobs.parallelFor(1, 1, [this](int, int) {
+        resolveContacts();
+    }, dependencies);
+}
+
+//Particle system
+inline LJob* LWorld::updateParticles(LJobSystem& jobs, const std::initializer_list<LJob*> dependencies) {
+    return jobs.parallelFor(mCount, ENTITY_JOB_GRAIN, [this](const int begin, const int end) {
+        updateParticlesRange(begin, end);
+    }, dependencies);
+}
+
+//Render system
+inline void LWorld::render(SDL_Renderer* mRenderer, LCamera& camera) {
+    PROFILE_ZONE("entities");
+
+    const float alpha = gDeltaTime.getAlpha();
+    const int camX = camera.getX(), camY = camera.getY();
+    for (int i = 0; i < mCount; ++i) {
+        if (!(mComponents[i] & (COMPONENT_SPRITE | COMPONENT_EMITTER))) {
+            continue;
+        }
+
+        //Blend between the last two moves
+        const float x = mPrevPosX[i] + (mPosX[i] - mPrevPosX[i]) * alpha;
+        const float y = mPrevPosY[i] + (mPosY[i] - mPrevPosY[i]) * alpha;
+
+        //Skip what the camera cannot see, with room for the sprite and its trail
+        const int margin = mRadius[i] + 16;
+        if (x + margin < camX || x - margin > camX + camera.getWidth() || y + margin < camY || y - margin > camY + camera.getHeight()) {
+            continue;
+        }
+
+        //Trail under the sprite
+        if (mComponents[i] & COMPONENT_EMITTER) {
+            gParticlePool.render(mRenderer, mEmitterFirst[i], mEmitterCount[i], camX, camY);
+        }
+
+        if (mComponents[i] & COMPONENT_SPRITE) {
+            const LTextureRegion& sprite = mSprites[mSprite[i]];
+            gSpriteBatch.draw(mRenderer, sprite, x - sprite.getWidth() / 2 - camX, y - sprite.getHeight() / 2 - camY);
+        }
+    }
+}
+
+//Removes every entity
+inline void LWorld::free() {
+    for (auto* component : {&mPosX, &mPosY, &mPrevPosX, &mPrevPosY, &mVelX, &mVelY}) {
+        component->clear();
+    }
+    mComponents.clear();
+    mRadius.clear();
+    mSprite.clear();
+    mEmitterFirst.clear();
+    mEmitterCount.clear();
+    mSprites.clear();
+    mCount = 0;
+}
+
+//Gets number of entities
+inline int LWorld::getCount() const {
+    return mCount;
+}
+
+//Mixes every position and velocity into a hash
+inline void LWorld::hashState(LStateHash& hash) const {
+    for (const auto* component : {&mPosX, &mPosY, &mVelX, &mVelY}) {
+        hash.add(component->data(), component->size() * sizeof(float));
+    }
+}
+
+//Checks if a circle leaves the level or touches a wall
+inline bool LWorld::isBlocked(const Circle& circle, const LTileMap& map) {
+    return circle.x - circle.r < 0 || circle.x + circle.r > map.getLevelWidth() || circle.y - circle.r < 0 || circle.y + circle.r > map.getLevelHeight() || touchesWall(&circle, map);
+}
+
+//Advances a range of entities by their velocity
+inline void LWorld::moveRange(const int begin, const int end, const float delta) {
+    for (int i = begin; i < end; ++i) {
+        mPrevPosX[i] = mPosX[i];
+        mPrevPosY[i] = mPosY[i];
+        mPosX[i] += mVelX[i] * delta;
+        mPosY[i] += mVelY[i] * delta;
+    }
+}
+
+//Sweeps the moves of a range of entities against the walls
+inline void LWorld::collideRange(const int begin, const int end, const LTileMap& map) {
+    for (int i = begin; i < end; ++i) {
+        if (!(mComponents[i] & COMPONENT_COLLIDER)) {
+            continue;
+        }
+
+        //Horizontal move first, like the dot
+        Circle collider = {static_cast<int>(mPrevPosX[i]), static_cast<int>(mPrevPosY[i]), mRadius[i]};
+        const int travelX = static_cast<int>(mPosX[i]) - collider.x;
+        const int reachX = sweepCircle(&collider, travelX, false, map);
+        if (reachX != travelX) {
+            mPosX[i] = static_cast<float>(collider.x + reachX);
+            mVelX[i] = -mVelX[i];
+        }
+
+        //Then vertical
+        collider.x = static_cast<int>(mPosX[i]);
+        const int travelY = static_cast<int>(mPosY[i]) - collider.y;
+        const int reachY = sweepCircle(&collider, travelY, true, map);
+        if (reachY != travelY) {
+            mPosY[i] = static_cast<float>(collider.y + reachY);
+            mVelY[i] = -mVelY[i];
+        }
+    }
+}
+
+//Respawns and ages the trails of a range of entities, their slots never overlap
+inline void LWorld::updateParticlesRange(const int begin, const int end) {
+    for (int i = begin; i < end; ++i) {
+        if (mComponents[i] & COMPONENT_EMITTER) {
+            gParticlePool.emit(mEmitterFirst[i], mEmitterCount[i], mPosX[i], mPosY[i], 20, &gShimmerTexture);
+            gParticlePool.update(mEmitterFirst[i], mEmitterCount[i]);
+        }
+    }
+}
+
+//Bounces apart every pair of touching colliders
+inline void LWorld::resolveContacts() {
+    //Only nearby pairs reach the narrowphase
+    mContacts.build(mPosX.data(), mPosY.data(), mRadius.data(), mCount);
+    mContacts.findPairs(mPairs);
+
+    //Candidates go through the circle kernel a batch at a time on whole pixels like checkCollision,
+    //positions do not change here so responding afterwards in pair order gives the same velocities
+    LCirclePairBatch batch;
+    batch.count = 0;
+    const LCollisionPair* batchPairs[COLLISION_BATCH_SIZE];
+    const auto respond = [&]() {
+        for (uint64_t touching = circlePairsTouch(batch); touching != 0; touching &= touching - 1) {
+            const LCollisionPair& pair = *batchPairs[std::countr_zero(touching)];
+            bounce(pair.a, pair.b);
+        }
+        batch.count = 0;
+    };
+
+    for (const LCollisionPair& pair : mPairs) {
+        const int a = pair.a, b = pair.b;
+        if (!(mComponents[a] & mComponents[b] & COMPONENT_COLLIDER)) {
+            continue;
+        }
+
+        batchPairs[batch.count] = &pair;
+        addCirclePair(batch, static_cast<int>(mPosX[a]), static_cast<int>(mPosY[a]), mRadius[a], static_cast<int>(mPosX[b]), static_cast<int>(mPosY[b]), mRadius[b]);
+        if (batch.count == COLLISION_BATCH_SIZE) {
+            respond();
+        }
+    }
+    respond();
+}
+
+//Bounces two touching entities off each other
+inline void LWorld::bounce(const int a, const int b) {
+    //Leave pairs already moving apart alone so overlapping entities do not bounce back and forth
+    const float normalX = mPosX[b] - mPosX[a], normalY = mPosY[b] - mPosY[a];
+    const float lengthSquared = normalX * normalX + normalY * normalY;
+    const float approach = (mVelX[b] - mVelX[a]) * normalX + (mVelY[b] - mVelY[a]) * normalY;
+    if (approach >= 0.f || lengthSquared == 0.f) {
+        return;
+    }
+
+    //Equal masses swap their velocity along the line between centres
+    const float impulse = approach / lengthSquared;
+    mVelX[a] += impulse * normalX;
+    mVelY[a] += impulse * normalY;
+    mVelX[b] -= impulse * normalX;
+    mVelY[b] -= impulse * normalY;
+}
+
+/*-----*
+Objects
+-------*/
+
+//Every entity besides the player's dot
+extern LWorld gWorld;
+
+#endif //LWORLD_H
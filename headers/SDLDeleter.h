@@ -0,0 +1,35 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef SDLDELETER_H
+#define SDLDELETER_H
+#include <memory>
+#include <SDL.h>
+
+//Destroys SDL objects with the matching SDL call
+struct SDLDeleter {
+    void operator()(SDL_Window* window) const {
+        SDL_DestroyWindow(window);
+    }
+
+    void operator()(SDL_Renderer* renderer) const {
+        SDL_DestroyRenderer(renderer);
+    }
+
+    void operator()(SDL_Texture* texture) const {
+        SDL_DestroyTexture(texture);
+    }
+
+    void operator()(SDL_Surface* surface) const {
+        SDL_FreeSurface(surface);
+    }
+};
+
+//Sole owners of SDL objects, movable but never copied
+using UniqueWindow = std::unique_ptr<SDL_Window, SDLDeleter>;
+using UniqueRenderer = std::unique_ptr<SDL_Renderer, SDLDeleter>;
+using UniqueTexture = std::unique_ptr<SDL_Texture, SDLDeleter>;
+using UniqueSurface = std::unique_ptr<SDL_Surface, SDLDeleter>;
+
+#endif //SDLDELETER_H
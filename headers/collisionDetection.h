@@ -7,7 +7,7 @@
 #include "Circle.h"
 #include "global.h"
 
-class LTile;
+class LTileMap;
 
 //Circle-Circle collision detector
 bool checkCollision(const SDL_Rect* a, const SDL_Rect* b);
@@ -19,6 +19,9 @@ bool checkCollision(const Circle* a, const Circle* b);
 bool checkCollision(const Circle* a, const SDL_Rect* b);
 
 //Circle-Tile collision detector
-bool touchesWall(const Circle* circle, LTile* tiles[]);
+bool touchesWall(const Circle* circle, const LTileMap& map);
+
+//Circle-Tile sweep, moves a circle along one axis and returns how many whole pixels it gets before touching a wall or leaving the level
+int sweepCircle(const Circle* circle, int distance, bool vertical, const LTileMap& map);
 
 #endif //COLLISIONDETECTION_H
@@ -0,0 +1,153 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#ifndef COLLISIONKERNEL_H
+#define COLLISIONKERNEL_H
+#include <algorithm>
+#include <cstdint>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+//Most shapes one batch holds, one bit each in a hit mask
+inline constexpr int COLLISION_BATCH_SIZE = 64;
+
+//Boxes stored one array per side so one vector register tests several at once
+struct LBoxBatch {
+    alignas(32) float minX[COLLISION_BATCH_SIZE];
+    alignas(32) float minY[COLLISION_BATCH_SIZE];
+    alignas(32) float maxX[COLLISION_BATCH_SIZE];
+    alignas(32) float maxY[COLLISION_BATCH_SIZE];
+    int count;
+};
+
+//Pairs of circles stored as the offset between their centres and the distance they touch within
+struct LCirclePairBatch {
+    alignas(32) float deltaX[COLLISION_BATCH_SIZE];
+    alignas(32) float deltaY[COLLISION_BATCH_SIZE];
+    alignas(32) float reach[COLLISION_BATCH_SIZE];
+    int count;
+};
+
+//Adds a box to a batch, false once it is full
+inline bool addBox(LBoxBatch& batch, const int x, const int y, const int w, const int h) {
+    if (batch.count == COLLISION_BATCH_SIZE) {
+        return false;
+    }
+    batch.minX[batch.count] = static_cast<float>(x);
+    batch.minY[batch.count] = static_cast<float>(y);
+    batch.maxX[batch.count] = static_cast<float>(x + w);
+    batch.maxY[batch.count] = static_cast<float>(y + h);
+    ++batch.count;
+    return true;
+}
+
+//Adds a pair of whole pixel circles to a batch, false once it is full
+inline bool addCirclePair(LCirclePairBatch& batch, const int ax, const int ay, const int ar, const int bx, const int by, const int br) {
+    if (batch.count == COLLISION_BATCH_SIZE) {
+        return false;
+    }
+    batch.deltaX[batch.count] = static_cast<float>(bx - ax);
+    batch.deltaY[batch.count] = static_cast<float>(by - ay);
+    batch.reach[batch.count] = static_cast<float>(ar + br);
+    ++batch.count;
+    return true;
+}
+
+//Circle-Box test for one pair, matches checkCollision for whole pixel shapes since their squares stay exact in a float
+inline bool circleTouchesBox(const float x, const float y, const float r, const float minX, const float minY, const float maxX, const float maxY) {
+    //Offset to the closest point on the box, zero on axes where the centre is inside
+    const float deltaX = std::max(std::max(minX - x, x - maxX), 0.f);
+    const float deltaY = std::max(std::max(minY - y, y - maxY), 0.f);
+    return deltaX*deltaX + deltaY*deltaY < r*r;
+}
+
+//One circle against boxes from first onwards, one box at a time
+inline uint64_t circleVsBoxesScalar(const float x, const float y, const float r, const LBoxBatch& boxes, const int first = 0) {
+    uint64_t mask = 0;
+    for (int i = first; i < boxes.count; ++i) {
+        if (circleTouchesBox(x, y, r, boxes.minX[i], boxes.minY[i], boxes.maxX[i], boxes.maxY[i])) {
+            mask |= uint64_t{1} << i;
+        }
+    }
+    return mask;
+}
+
+//Pairs from first onwards, one at a time, matches checkCollision while the squares stay exact in a float,
+//which holds for any pair the broadphase box test lets through
+inline uint64_t circlePairsTouchScalar(const LCirclePairBatch& pairs, const int first = 0) {
+    uint64_t mask = 0;
+    for (int i = first; i < pairs.count; ++i) {
+        if (pairs.deltaX[i]*pairs.deltaX[i] + pairs.deltaY[i]*pairs.deltaY[i] < pairs.reach[i]*pairs.reach[i]) {
+            mask |= uint64_t{1} << i;
+        }
+    }
+    return mask;
+}
+
+//One circle against every box in a batch, bit i is set when box i is touched
+inline uint64_t circleVsBoxes(const float x, const float y, const float r, const LBoxBatch& boxes) {
+    uint64_t mask = 0;
+    int i = 0;
+
+#ifdef __AVX__
+    //Eight boxes per step
+    {
+        const __m256 centreX = _mm256_set1_ps(x), centreY = _mm256_set1_ps(y);
+        const __m256 radiusSquared = _mm256_set1_ps(r*r), zero = _mm256_setzero_ps();
+        for (; i + 8 <= boxes.count; i += 8) {
+            const __m256 deltaX = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_load_ps(boxes.minX + i), centreX), _mm256_sub_ps(centreX, _mm256_load_ps(boxes.maxX + i))), zero);
+            const __m256 deltaY = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_load_ps(boxes.minY + i), centreY), _mm256_sub_ps(centreY, _mm256_load_ps(boxes.maxY + i))), zero);
+            const __m256 distance = _mm256_add_ps(_mm256_mul_ps(deltaX, deltaX), _mm256_mul_ps(deltaY, deltaY));
+            mask |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(distance, radiusSquared, _CMP_LT_OQ))) << i;
+        }
+    }
+#endif
+
+#ifdef __SSE2__
+    //Four boxes per step, whatever the wider path left over
+    {
+        const __m128 centreX = _mm_set1_ps(x), centreY = _mm_set1_ps(y);
+        const __m128 radiusSquared = _mm_set1_ps(r*r), zero = _mm_setzero_ps();
+        for (; i + 4 <= boxes.count; i += 4) {
+            const __m128 deltaX = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_load_ps(boxes.minX + i), centreX), _mm_sub_ps(centreX, _mm_load_ps(boxes.maxX + i))), zero);
+            const __m128 deltaY = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_load_ps(boxes.minY + i), centreY), _mm_sub_ps(centreY, _mm_load_ps(boxes.maxY + i))), zero);
+            const __m128 distance = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+            mask |= static_cast<uint64_t>(_mm_movemask_ps(_mm_cmplt_ps(distance, radiusSquared))) << i;
+        }
+    }
+#endif
+
+    //The rest one by one
+    return mask | circleVsBoxesScalar(x, y, r, boxes, i);
+}
+
+//Every pair in a batch, bit i is set when the circles of pair i touch
+inline uint64_t circlePairsTouch(const LCirclePairBatch& pairs) {
+    uint64_t mask = 0;
+    int i = 0;
+
+#ifdef __AVX__
+    //Eight pairs per step
+    for (; i + 8 <= pairs.count; i += 8) {
+        const __m256 deltaX = _mm256_load_ps(pairs.deltaX + i), deltaY = _mm256_load_ps(pairs.deltaY + i), reach = _mm256_load_ps(pairs.reach + i);
+        const __m256 distance = _mm256_add_ps(_mm256_mul_ps(deltaX, deltaX), _mm256_mul_ps(deltaY, deltaY));
+        mask |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(distance, _mm256_mul_ps(reach, reach), _CMP_LT_OQ))) << i;
+    }
+#endif
+
+#ifdef __SSE2__
+    //Four pairs per step
+    for (; i + 4 <= pairs.count; i += 4) {
+        const __m128 deltaX = _mm_load_ps(pairs.deltaX + i), deltaY = _mm_load_ps(pairs.deltaY + i), reach = _mm_load_ps(pairs.reach + i);
+        const __m128 distance = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+        mask |= static_cast<uint64_t>(_mm_movemask_ps(_mm_cmplt_ps(distance, _mm_mul_ps(reach, reach)))) << i;
+    }
+#endif
+
+    //The rest one by one
+    return mask | circlePairsTouchScalar(pairs, i);
+}
+
+#endif //COLLISIONKERNEL_H
@@ -5,10 +5,10 @@
 #ifndef GETDISTANCE_H
 #define GETDISTANCE_H
 
-//Calculate distance between centres of two circles
-inline double distanceSquared(const int x1, const int y1, const int x2, const int y2) {
-    const int deltaX = x2 - x1;
-    const int deltaY = y2 - y1;
+//Calculate distance between centres of two circles, in integers all the way so it is exact and never overflows
+inline long long distanceSquared(const int x1, const int y1, const int x2, const int y2) {
+    const long long deltaX = static_cast<long long>(x2) - x1;
+    const long long deltaY = static_cast<long long>(y2) - y1;
     return deltaX*deltaX + deltaY*deltaY;
 }
 
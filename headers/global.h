@@ -17,7 +17,11 @@ Constant variables
 extern const int WINDOW_WIDTH;
 extern const int WINDOW_HEIGHT;
 extern const int SCREEN_FPS;
-extern const int SCREEN_TICKS_PER_FRAME;
+
+//Simulation timestep constants
+extern const bool FIXED_TIMESTEP;
+extern const int SIMULATION_TICK_RATE;
+extern const int MAX_SIMULATION_STEPS;
 
 //Button constants
 extern const int BUTTON_WIDTH;
@@ -27,16 +31,17 @@ extern const int TOTAL_BUTTONS;
 //Analog joystick dead zone
 extern const int JOYSTICK_DEAD_ZONE;
 
-//The dimensions of the level
-extern const int LEVEL_WIDTH;
-extern const int LEVEL_HEIGHT;
-
 //Tile constants
 extern const int TILE_WIDTH;
 extern const int TILE_HEIGHT;
-extern const int TOTAL_TILES;
 extern const int TOTAL_TILE_SPRITES;
 
+//Draw tiles from pre-baked chunks instead of one by one
+extern const bool BAKE_TILE_LAYER;
+
+//Reload edited images and maps while running
+extern const bool HOT_RELOAD;
+
 //The different tile sprites
 enum TILESPRITES {
     TILE_RED,
@@ -73,6 +78,9 @@ extern const SDL_Color textColor;
 //Frames elapsed
 extern int countedFrames;
 
+//Wandering agents spawned with the level
+extern int totalAgents;
+
 //Main loop flag
 extern bool quit;
 
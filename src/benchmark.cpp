@@ -0,0 +1,246 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#include <SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "../headers/AllHeaders.h"
+#include "../headers/global.h"
+
+/*-------------------*
+Allocation accounting
+---------------------*/
+
+//Heap allocations made by the whole program
+std::atomic<Uint64> gAllocationCount = 0;
+std::atomic<Uint64> gAllocationBytes = 0;
+
+void* operator new(const std::size_t size) {
+    ++gAllocationCount;
+    gAllocationBytes += size;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+/*------------*
+Scripted input
+--------------*/
+
+//A key change at a frame of the input loop
+struct ScriptedKey {
+    int frame;
+    SDL_Keycode key;
+    bool pressed;
+};
+
+//Drives the dot around the level, repeats every SCRIPT_LENGTH frames
+constexpr int SCRIPT_LENGTH = 480;
+constexpr ScriptedKey INPUT_SCRIPT[] = {
+    {0, SDLK_RIGHT, true},
+    {40, SDLK_DOWN, true},
+    {120, SDLK_RIGHT, false},
+    {160, SDLK_DOWN, false},
+    {160, SDLK_LEFT, true},
+    {200, SDLK_UP, true},
+    {280, SDLK_LEFT, false},
+    {320, SDLK_UP, false},
+    {320, SDLK_RIGHT, true},
+    {400, SDLK_RIGHT, false},
+};
+
+//Builds the key event the window would have sent
+SDL_Event makeKeyEvent(const SDL_Keycode key, const bool pressed) {
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = pressed ? SDL_KEYDOWN : SDL_KEYUP;
+    event.key.state = pressed ? SDL_PRESSED : SDL_RELEASED;
+    event.key.repeat = 0;
+    event.key.keysym.sym = key;
+    return event;
+}
+
+/*------------*
+Main functions
+--------------*/
+
+//Starts up the SDL and creates window -> init.cpp
+bool init();
+
+//Loads media -> loadMedia.cpp
+bool loadMedia();
+
+//Frees media and shuts down SDL -> close.cpp
+void close();
+
+//Handles event queues -> eventHandler.cpp
+void eventHandler(bool &quit, SDL_Event e);
+
+//Render function -> render.cpp
+void render();
+
+//Gets a percentile of sorted frame times
+Uint64 percentile(const std::vector<Uint64>& sorted, const double fraction) {
+    const size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+//Runs the game loop headless with scripted input and reports frame statistics
+int main(int argc, char* args[]) {
+    //Frames to measure and frames to run before measuring
+    int totalFrames = 2000;
+    int warmupFrames = 60;
+    const char* tracePath = nullptr;
+
+    //Simulation workers, one per spare core unless told otherwise
+    int workers = -1;
+
+    //Read options
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(args[i], "--frames") == 0 && i + 1 < argc) {
+            totalFrames = std::max(1, atoi(args[++i]));
+        }
+        else if (strcmp(args[i], "--warmup") == 0 && i + 1 < argc) {
+            warmupFrames = std::max(0, atoi(args[++i]));
+        }
+        else if (strcmp(args[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = args[++i];
+        }
+        else if (strcmp(args[i], "--agents") == 0 && i + 1 < argc) {
+            totalAgents = std::max(0, atoi(args[++i]));
+        }
+        else if (strcmp(args[i], "--workers") == 0 && i + 1 < argc) {
+            workers = std::max(0, atoi(args[++i]));
+        }
+        else {
+            printf("Usage: %s [--frames N] [--warmup N] [--agents N] [--workers N] [--trace profile.json]\n", args[0]);
+            return 1;
+        }
+    }
+
+    //Run without a display, GPU or sound card unless told otherwise
+    SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+    int exitCode = 1;
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else if (!loadMedia()) {
+        printf("Failed to load media!\n");
+    }
+    else {
+        //Run as fast as possible
+        gFramePacer.setMode(gWindow.getRenderer(), PACE_UNCAPPED);
+        gJobSystem.start(workers);
+        if (FIXED_TIMESTEP) {
+            gDeltaTime.setFixedTimestep(SIMULATION_TICK_RATE, MAX_SIMULATION_STEPS);
+        }
+        if (tracePath != nullptr) {
+            gProfiler.setEnabled(true);
+        }
+
+        std::vector<Uint64> frameTimes;
+        frameTimes.reserve(totalFrames);
+
+        Uint64 allocationCount = 0, allocationBytes = 0;
+        Uint64 drawCalls = 0, quads = 0;
+        LHighResTimer frameTimer, runTimer;
+        fpsTimer.start();
+
+        for (int frame = 0; frame < warmupFrames + totalFrames && !quit; ++frame) {
+            //Start measuring once warmed up
+            if (frame == warmupFrames) {
+                allocationCount = gAllocationCount;
+                allocationBytes = gAllocationBytes;
+                runTimer.start();
+            }
+            frameTimer.start();
+            gProfiler.beginFrame();
+
+            //Feed this frame's scripted keys
+            for (const ScriptedKey& scripted : INPUT_SCRIPT) {
+                if (scripted.frame == frame % SCRIPT_LENGTH) {
+                    eventHandler(quit, makeKeyEvent(scripted.key, scripted.pressed));
+                }
+            }
+
+            //Drain whatever the video driver queued
+            while (SDL_PollEvent(&e) != 0) {
+                eventHandler(quit, e);
+            }
+
+            //Update and draw
+            render();
+
+            gProfiler.endFrame();
+            if (frame >= warmupFrames) {
+                frameTimes.push_back(frameTimer.getTicks());
+                drawCalls += gSpriteBatch.getDrawCalls();
+                quads += gSpriteBatch.getQuads();
+            }
+        }
+
+        const Uint64 runTime = runTimer.getTicks();
+        allocationCount = gAllocationCount - allocationCount;
+        allocationBytes = gAllocationBytes - allocationBytes;
+
+        if (frameTimes.empty()) {
+            printf("No frames were measured!\n");
+        }
+        else {
+            //Report
+            std::sort(frameTimes.begin(), frameTimes.end());
+            const double measured = static_cast<double>(frameTimes.size());
+            printf("video driver: %s, renderer: software\n", SDL_GetCurrentVideoDriver());
+            printf("agents: %d, simulation workers: %d\n", gWorld.getCount(), gJobSystem.getWorkerCount());
+            printf("frames: %zu in %.3f s, %.1f frames/s\n", frameTimes.size(), static_cast<double>(runTime) / NANOSECONDS_PER_SECOND, measured * NANOSECONDS_PER_SECOND / runTime);
+            printf("frame time ms: p50 %.3f, p95 %.3f, p99 %.3f, max %.3f\n",
+                static_cast<double>(percentile(frameTimes, 0.50)) / NANOSECONDS_PER_MILLISECOND,
+                static_cast<double>(percentile(frameTimes, 0.95)) / NANOSECONDS_PER_MILLISECOND,
+                static_cast<double>(percentile(frameTimes, 0.99)) / NANOSECONDS_PER_MILLISECOND,
+                static_cast<double>(frameTimes.back()) / NANOSECONDS_PER_MILLISECOND);
+            printf("draw calls: %.1f per frame for %.1f quads\n", drawCalls / measured, quads / measured);
+            printf("allocations: %llu (%llu bytes), %.2f per frame\n", static_cast<unsigned long long>(allocationCount), static_cast<unsigned long long>(allocationBytes), allocationCount / measured);
+
+            if (tracePath != nullptr) {
+                gProfiler.exportChromeTrace(tracePath);
+            }
+            exitCode = 0;
+        }
+    }
+
+    //Free resources and close SDL
+    close();
+
+    return exitCode;
+}
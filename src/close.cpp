@@ -24,23 +24,25 @@ void freeController() {
 
 //Frees media and shuts down SDL
 void close() {
-    //Deallocate tiles
-    for( int i = 0; i < TOTAL_TILES; ++i )
-    {
-        if( tiles[ i ] != nullptr )
-        {
-            delete tiles[ i ];
-            tiles[ i ] = nullptr;
-        }
-    }
+    //Let reloads in flight land before what they touch goes away
+    gHotReloader.close();
+    gJobSystem.stop();
+
+    //Stop streaming and deallocate tiles
+    gChunkStreamer.close();
+    gTileMap.free();
+
+    //Free baked tiles
+    gTileLayer.free();
 
-    //Free loaded image
-    gFPSTextTexture.free();
-    gShimmerTexture.free();
-    gTileTexture.free();
+    //Free loaded images, regions only point into the atlas
+    gFontAtlas.free();
+    gTextureAtlas.free();
+    gAssetCache.clear();
 
     //Free dots
     dot.free();
+    gWorld.free();
 
     //Close game controller
     freeController();
@@ -3,8 +3,24 @@
 //
 
 #include "../headers/collisionDetection.h"
-#include "../headers/LTile.h"
+#include "../headers/collisionKernel.h"
+#include "../headers/LTileMap.h"
 #include "../headers/getDistance.h"
+#include "../headers/LProfiler.h"
+#include <algorithm>
+#include <cmath>
+
+//Smallest whole number whose square reaches value
+static int ceilSqrt(const int value) {
+    int root = static_cast<int>(std::sqrt(static_cast<float>(value)));
+    while (root * root < value) {
+        ++root;
+    }
+    while (root > 0 && (root - 1) * (root - 1) >= value) {
+        --root;
+    }
+    return root;
+}
 
 //Circle-Circle collision detector
 bool checkCollision(const SDL_Rect* a, const SDL_Rect* b) {
@@ -98,18 +114,111 @@ bool checkCollision(const Circle* a, const SDL_Rect* b) {
     return false;
 }
 
-bool touchesWall(const Circle* circle, LTile* tiles[]) {
-    //Go through the tiles
-    for (int i = 0; i < TOTAL_TILES; ++i) {
-        //If the tile is a wall type tile
-        if (tiles[i]->getType() >= TILE_CENTER && tiles[i]->getType() <= TILE_TOPLEFT) {
-            //If the collision circle touches the wall tile
-            if (checkCollision(circle, tiles[i]->getBox())) {
-                return true;
+//Circle-Tile collision detector, called per entity so it is timed by its callers
+bool touchesWall(const Circle* circle, const LTileMap& map) {
+    //Grid cells overlapped by the circle's bounding box, clamped to the map
+    const int leftColumn = std::max(0, (circle->x - circle->r) / TILE_WIDTH);
+    const int rightColumn = std::min(map.getWidth() - 1, (circle->x + circle->r) / TILE_WIDTH);
+    const int topRow = std::max(0, (circle->y - circle->r) / TILE_HEIGHT);
+    const int bottomRow = std::min(map.getHeight() - 1, (circle->y + circle->r) / TILE_HEIGHT);
+
+    //Wall tiles under the bounding box, tested a batch at a time
+    LBoxBatch walls;
+    walls.count = 0;
+    const float x = static_cast<float>(circle->x), y = static_cast<float>(circle->y), r = static_cast<float>(circle->r);
+    for (int row = topRow; row <= bottomRow; ++row) {
+        for (int column = leftColumn; column <= rightColumn; ++column) {
+            if (!map.isWall(column, row)) {
+                continue;
             }
+
+            //Test a full batch before starting the next, huge circles cover more tiles than one holds
+            if (walls.count == COLLISION_BATCH_SIZE) {
+                if (circleVsBoxes(x, y, r, walls) != 0) {
+                    return true;
+                }
+                walls.count = 0;
+            }
+            const SDL_Rect box = map.getTileRect(column, row);
+            addBox(walls, box.x, box.y, box.w, box.h);
         }
     }
 
-    //If no wall tiles were touched
-    return false;
-}
\ No newline at end of file
+    //If the collision circle touches any wall tile
+    return circleVsBoxes(x, y, r, walls) != 0;
+}
+
+//Circle-Tile sweep, one query however far the circle goes
+int sweepCircle(const Circle* circle, int distance, const bool vertical, const LTileMap& map) {
+    //Work along the motion and across it so both axes share the code
+    const int along = vertical ? circle->y : circle->x;
+    const int across = vertical ? circle->x : circle->y;
+    const int r = circle->r;
+    const int tileAlong = vertical ? TILE_HEIGHT : TILE_WIDTH;
+    const int tileAcross = vertical ? TILE_WIDTH : TILE_HEIGHT;
+    const int tilesAlong = vertical ? map.getHeight() : map.getWidth();
+    const int tilesAcross = vertical ? map.getWidth() : map.getHeight();
+    const int levelSize = vertical ? map.getLevelHeight() : map.getLevelWidth();
+
+    //Stop at the level edges
+    if (distance > 0) {
+        distance = std::min(distance, std::max(0, levelSize - r - along));
+    }
+    else {
+        distance = std::max(distance, std::min(0, r - along));
+    }
+    if (distance == 0 || tilesAlong == 0 || tilesAcross == 0) {
+        return distance;
+    }
+    const int step = distance > 0 ? 1 : -1;
+
+    //Rows or columns the circle's side sweeps through
+    const int firstLine = std::max(0, (across - r) / tileAcross);
+    const int lastLine = std::min(tilesAcross - 1, (across + r) / tileAcross);
+
+    //Tiles along the motion, nearest first
+    const int firstTile = std::clamp(along / tileAlong, 0, tilesAlong - 1);
+    const int lastTile = std::clamp((along + distance + step * r) / tileAlong, 0, tilesAlong - 1);
+    for (int tile = firstTile; tile != lastTile + step; tile += step) {
+        //Tiles from here on cannot stop the circle sooner
+        const int nearEdge = step > 0 ? tile * tileAlong : (tile + 1) * tileAlong;
+        if (step * (nearEdge - along) - r >= step * distance) {
+            break;
+        }
+
+        for (int line = firstLine; line <= lastLine; ++line) {
+            const int column = vertical ? line : tile;
+            const int row = vertical ? tile : line;
+            if (!map.isWall(column, row)) {
+                continue;
+            }
+
+            //Sides of the wall tile along and across the motion
+            const SDL_Rect box = map.getTileRect(column, row);
+            const int boxMin = vertical ? box.y : box.x;
+            const int boxMax = boxMin + (vertical ? box.h : box.w);
+            const int acrossMin = vertical ? box.x : box.y;
+            const int acrossMax = acrossMin + (vertical ? box.w : box.h);
+
+            //The circle passes tiles it is too far from across the motion, or stops before reaching
+            const int gapAcross = std::max({acrossMin - across, across - acrossMax, 0});
+            const int reach = r * r - gapAcross * gapAcross;
+            if (reach <= 0 || (step > 0 ? boxMin - along - r : along - boxMax - r) >= step * distance) {
+                continue;
+            }
+
+            //Gap along the motion at the time of impact, rounded up to the nearest whole pixel that does not touch
+            const int clearance = ceilSqrt(reach);
+
+            //Only tiles ahead and untouched can stop it, so a circle caught in a wall is free to walk out
+            if (step > 0 && boxMin - along >= clearance) {
+                distance = std::min(distance, boxMin - along - clearance);
+            }
+            else if (step < 0 && along - boxMax >= clearance) {
+                distance = std::max(distance, boxMax - along + clearance);
+            }
+        }
+    }
+
+    return distance;
+}
@@ -11,6 +11,7 @@ extern SDL_Rect camera;
 
 // ReSharper disable once CppPassValueParameterByConstReference
 void eventHandler(bool &quit, SDL_Event e) {
+    PROFILE_ZONE("eventHandler");
 
     //User requests quit
     if(e.type == SDL_QUIT) quit = true;
@@ -20,10 +21,29 @@ void eventHandler(bool &quit, SDL_Event e) {
             case SDLK_ESCAPE:
                 quit = true;
                 break;
+            //Cycle frame pacing mode
+            case SDLK_F3:
+                gFramePacer.setMode(gWindow.getRenderer(), static_cast<PacingMode>((gFramePacer.getMode() + 1) % TOTAL_PACING_MODES));
+                fpsTimer.start();
+                countedFrames = 0;
+                break;
+            //Toggle frame profiler
+            case SDLK_F1:
+                gProfiler.setEnabled(!gProfiler.isEnabled());
+                printf("Profiler %s\n", gProfiler.isEnabled() ? "enabled" : "disabled");
+                break;
+            //Export recorded frames
+            case SDLK_F2:
+                gProfiler.exportChromeTrace("profile.json");
+                break;
             default:
                 break;
         }
     }
+    //Render target contents were lost, bake tiles again
+    else if (e.type == SDL_RENDER_TARGETS_RESET && gTileLayer.isBaked()) {
+        gTileLayer.bake(gWindow.getRenderer(), gTileMap);
+    }
     else {
         if (e.type == SDL_JOYBUTTONDOWN) {
             //Use game controller
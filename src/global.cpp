@@ -14,7 +14,11 @@ Constant variables
 const int WINDOW_WIDTH = 640;
 const int WINDOW_HEIGHT = 480;
 const int SCREEN_FPS = 60;
-const int SCREEN_TICKS_PER_FRAME = 1000 / SCREEN_FPS;
+
+//Simulation timestep constants
+const bool FIXED_TIMESTEP = true;
+const int SIMULATION_TICK_RATE = 120;
+const int MAX_SIMULATION_STEPS = 8;
 
 //Button constants
 const int BUTTON_WIDTH = 300;
@@ -24,16 +28,17 @@ const int TOTAL_BUTTONS = 4;
 //Analog joystick dead zone
 const int JOYSTICK_DEAD_ZONE = 1000;
 
-//The dimensions of the level
-const int LEVEL_WIDTH = 1280;
-const int LEVEL_HEIGHT = 960;
-
 //Tile constants
 const int TILE_WIDTH = 80;
 const int TILE_HEIGHT = 80;
-const int TOTAL_TILES = 192;
 const int TOTAL_TILE_SPRITES = 12;
 
+//Draw tiles from pre-baked chunks instead of one by one
+const bool BAKE_TILE_LAYER = true;
+
+//Reload edited images and maps while running
+const bool HOT_RELOAD = true;
+
 /*--------------------*
 Non-constant variables
 ----------------------*/
@@ -53,10 +58,10 @@ SDL_Rect* gDisplayBounds = nullptr;
 SDL_Rect gTileClips[TOTAL_TILE_SPRITES];
 
 //The frames per second timer
-LTimer fpsTimer;
+LHighResTimer fpsTimer;
 
-//The frames per second cap timer
-LTimer capTimer;
+//Paces the main loop
+LFramePacer gFramePacer;
 
 //Set text color as white
 const SDL_Color textColor = {0xFF, 0xFF, 0xFF, 0xFF};
@@ -64,6 +69,9 @@ const SDL_Color textColor = {0xFF, 0xFF, 0xFF, 0xFF};
 //Start counting frames per second
 int countedFrames = 0;
 
+//Wandering agents spawned with the level
+int totalAgents = TOTAL_AGENTS;
+
 //Main loop flag
 bool quit = false;
 
@@ -94,19 +102,49 @@ Objects
 //The dot that will be moving around on the screen
 LDot dot(LDot::DOT_WIDTH / 2, LDot::DOT_HEIGHT / 2);
 
+//Every entity besides the player's dot
+LWorld gWorld;
+
+//Runs simulation systems across every core
+LJobSystem gJobSystem;
+
 //The window we're rendering to
 LWindow gWindow;
 
-//Text texture
-LTexture gFPSTextTexture;
+//Batches the sprites of a frame
+LSpriteBatch gSpriteBatch;
+
+//Glyphs of the global font
+LGlyphAtlas gFontAtlas;
+
+//Sprites of the level packed together
+LTextureAtlas gTextureAtlas;
+
+//Images and textures shared by path
+LAssetCache gAssetCache;
+
+//Reloads edited assets while the game runs
+LHotReloader gHotReloader;
+
+//Records or replays the input driving the simulation
+LInputRecorder gInputRecorder;
 
 //Tile sprite sheet
-LTexture gTileTexture;
+LTextureRegion gTileTexture;
 
 //Shimmer texture
-LTexture gShimmerTexture;
+LTextureRegion gShimmerTexture;
+
+//The level's tiles
+LTileMap gTileMap;
+
+//Baked static tiles
+LTileLayer gTileLayer;
+
+//Streams the level around the camera when it is too large to keep resident
+LChunkStreamer gChunkStreamer;
 
-//Tiles
-LTile* tiles[TOTAL_TILES];
+//Particles of every emitter
+LParticlePool gParticlePool(MAX_PARTICLES);
 
 
@@ -115,6 +115,9 @@ bool init() {
         }
     }
 
+    //Start a simulation worker per spare core
+    gJobSystem.start();
+
     return success;
 }
 
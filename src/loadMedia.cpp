@@ -4,41 +4,151 @@
 #include "../headers/global.h"
 #include "../headers/AllHeaders.h"
 
+//Reloads the level's sprites and tile map when their files change
+void watchMedia(SDL_Renderer* renderer) {
+    //Sprites are decoded off the render thread and redrawn into their atlas slot
+    for (const std::string name : {"dot.bmp", "tiles.png", "shimmer.bmp"}) {
+        const std::string path = "../assets/images/" + name;
+        auto surface = std::make_shared<LSurfaceHandle>();
+        gHotReloader.watch(path, [path, surface] {
+            *surface = gAssetCache.reloadSurface(path);
+            return *surface != nullptr;
+        }, [renderer, name, path, surface] {
+            const bool replaced = gTextureAtlas.replaceImage(name, surface->get());
+            gAssetCache.reloadTexture(renderer, path);
+            surface->reset();
+
+            //Baked tiles hold copies of the old sheet
+            if (replaced && name == "tiles.png" && BAKE_TILE_LAYER && !gTileMap.isStreamed()) {
+                gTileLayer.bake(renderer, gTileMap);
+            }
+            return replaced;
+        });
+    }
+
+    //Small levels are parsed off the render thread, streamed ones reopen around the camera
+    const std::string mapPath = "../data/lazy.lmap";
+    auto map = std::make_shared<LTileMap>();
+    gHotReloader.watch(mapPath, [mapPath, map] {
+        return LChunkStreamer::shouldStream(mapPath) || map->loadFromFile(mapPath);
+    }, [renderer, mapPath, map] {
+        gChunkStreamer.close();
+        gTileLayer.free();
+        if (map->getWidth() == 0) {
+            if (!gChunkStreamer.open(mapPath, gTileMap)) {
+                printf("Failed to stream tile map!\n");
+                return false;
+            }
+            gChunkStreamer.prime(gTileMap, gCamera);
+        }
+        else {
+            gTileMap = std::move(*map);
+            map->free();
+            if (BAKE_TILE_LAYER) {
+                gTileLayer.bake(renderer, gTileMap);
+            }
+        }
+        return true;
+    });
+}
+
 //Loads media
 bool loadMedia() {
-    //Loading success flag
-    bool success = true;
-
     SDL_Renderer *gRenderer = gWindow.getRenderer();
 
-    //Open the font
-    gFont = TTF_OpenFont("../assets/fonts/lazy.ttf", 28);
-    if (gFont == nullptr) {
-        printf("Failed to load lazy font! SDL_ttf Error: %s\n", TTF_GetError());
-        success = false;
-    }
+    //Images decoded by the workers, held until packed then left to the cache
+    LSurfaceHandle dotSurface;
+    LSurfaceHandle tileSurface;
+    LSurfaceHandle shimmerSurface;
 
-    //Load dot texture
-    if (!dot.loadTexture(gRenderer, "../assets/images/dot.bmp")) {
-        printf("Failed to load dot.png!\n");
-        success = false;
-    }
+    //Files are read and decoded in parallel, textures are created here as each one arrives
+    LAssetLoader loader;
 
-    if (!gTileTexture.loadFromFile(gRenderer, "../assets/images/tiles.png")) {
-        printf("Failed to load tiles.png!\n");
-        success = false;
-    }
+    //Open the font, then rasterize its glyphs once
+    loader.addTask("lazy.ttf", [] {
+        gFont = TTF_OpenFont("../assets/fonts/lazy.ttf", 28);
+        if (gFont == nullptr) {
+            printf("Failed to load lazy font! SDL_ttf Error: %s\n", TTF_GetError());
+        }
+        return gFont != nullptr;
+    }, [gRenderer] {
+        if (!gFontAtlas.loadFromFont(gRenderer, gFont)) {
+            printf("Failed to build glyph atlas!\n");
+            return false;
+        }
+        return true;
+    });
 
-    //Load tile map
-    if (!setTiles(tiles, "../data/lazy.map")) {
-        printf("Failed to set tiles!\n");
-        success = false;
-    }
+    //Decode the level's sprites
+    const int dotImage = loader.addTask("dot.bmp", [&dotSurface] {
+        dotSurface = gAssetCache.getSurface("../assets/images/dot.bmp");
+        return dotSurface != nullptr;
+    });
+    const int tileImage = loader.addTask("tiles.png", [&tileSurface] {
+        tileSurface = gAssetCache.getSurface("../assets/images/tiles.png");
+        return tileSurface != nullptr;
+    });
+    const int shimmerImage = loader.addTask("shimmer.bmp", [&shimmerSurface] {
+        shimmerSurface = gAssetCache.getSurface("../assets/images/shimmer.bmp");
+        return shimmerSurface != nullptr;
+    });
+
+    //Pack them into shared pages so tiles, particles and the dot batch together
+    const int atlas = loader.addTask("atlas", nullptr, [gRenderer, &dotSurface, &tileSurface, &shimmerSurface] {
+        gTextureAtlas.addImage("dot.bmp", dotSurface.get());
+        gTextureAtlas.addImage("tiles.png", tileSurface.get());
+        gTextureAtlas.addImage("shimmer.bmp", shimmerSurface.get());
+        if (!gTextureAtlas.pack(gRenderer)) {
+            printf("Failed to pack texture atlas!\n");
+            return false;
+        }
+
+        dot.setTexture(gTextureAtlas.getRegion("dot.bmp"));
+        gTileTexture = gTextureAtlas.getRegion("tiles.png");
+        setTileClips();
+        gShimmerTexture = gTextureAtlas.getRegion("shimmer.bmp");
+        return true;
+    }, {dotImage, tileImage, shimmerImage});
+
+    //Load tile map, levels too large to keep resident are streamed around the camera
+    const int tileMap = loader.addTask("lazy.lmap", [] {
+        const std::string mapPath = "../data/lazy.lmap";
+        if (LChunkStreamer::shouldStream(mapPath)) {
+            if (!gChunkStreamer.open(mapPath, gTileMap)) {
+                printf("Failed to stream tile map!\n");
+                return false;
+            }
+            gChunkStreamer.prime(gTileMap, gCamera);
+        }
+        else if (!gTileMap.loadFromFile(mapPath)) {
+            printf("Failed to load tile map!\n");
+            return false;
+        }
+        return true;
+    });
+
+    //Pre-render the static tiles once both are in, falls back to drawing visible tiles on failure
+    loader.addTask("tile layer", nullptr, [gRenderer] {
+        if (BAKE_TILE_LAYER) {
+            gTileLayer.bake(gRenderer, gTileMap);
+        }
+        return true;
+    }, {atlas, tileMap});
+
+    //Scatter the agents over the level's open floor
+    loader.addTask("agents", nullptr, [] {
+        gWorld.spawnAgents(totalAgents, gTileMap, gTextureAtlas.getRegion("dot.bmp"));
+        return true;
+    }, {atlas, tileMap});
+
+    //Loading success flag
+    const bool success = loader.run();
+    loader.printTimings();
+    gAssetCache.printUsage();
 
-    //Load shimmer texture
-    if (!gShimmerTexture.loadFromFile(gRenderer, "../assets/images/shimmer.bmp")) {
-        printf("Failed to load shimmer.bmp!\n");
-        success = false;
+    //Watch what was loaded so edits show up without restarting
+    if (success && HOT_RELOAD && gHotReloader.open()) {
+        watchMedia(gRenderer);
     }
 
     //Free gRenderer
@@ -1,5 +1,6 @@
 #include <SDL.h>
 #include <cstdio>
+#include <cstring>
 #include "../headers/AllHeaders.h"
 #include "../headers/global.h"
 
@@ -29,8 +30,74 @@ void eventHandler(bool &quit, SDL_Event e);
 //Render function -> render.cpp
 void render();
 
+//Advances the simulation one fixed step -> render.cpp
+void simulate();
+
+//Hashes what the simulation ended with, replays compare it against the recording
+Uint64 hashState() {
+    LStateHash hash;
+    dot.hashState(hash);
+
+    //Agents still move in floats, fixed point builds leave them out so replays check across builds
+#ifndef FIXED_POINT_PHYSICS
+    gWorld.hashState(hash);
+#endif
+    return hash.get();
+}
+
+//Runs a replay without drawing or waiting, as fast as the simulation steps
+void replayHeadless() {
+    LHighResTimer timer;
+    timer.start();
+    while (!quit) {
+        simulate();
+        dot.setCamera(gCamera, gTileMap);
+        gChunkStreamer.update(gTileMap, gCamera, dot.getVelX(), dot.getVelY());
+    }
+
+    const double seconds = static_cast<double>(timer.getTicks()) / NANOSECONDS_PER_SECOND;
+    const double played = static_cast<double>(gInputRecorder.getTick()) / SIMULATION_TICK_RATE;
+    printf("Replayed %llu ticks, %.2f s of play in %.3f s, %.1fx real time\n", static_cast<unsigned long long>(gInputRecorder.getTick()), played, seconds, seconds > 0 ? played / seconds : 0.0);
+}
+
 //Main loop
 int main(int argc, char* args[]) {
+    //Options: --record <file> captures input, --replay <file> feeds it back, --headless replays without a window
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(args[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = args[++i];
+        }
+        else if (strcmp(args[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = args[++i];
+        }
+        else if (strcmp(args[i], "--headless") == 0) {
+            headless = true;
+        }
+        else {
+            printf("Usage: %s [--record <file> | --replay <file> [--headless]]\n", args[0]);
+            return 1;
+        }
+    }
+    if ((recordPath != nullptr && replayPath != nullptr) || (headless && replayPath == nullptr)) {
+        printf("Record or replay, headless only replays\n");
+        return 1;
+    }
+    if ((recordPath != nullptr || replayPath != nullptr) && !FIXED_TIMESTEP) {
+        printf("Recording and replaying need a fixed timestep\n");
+        return 1;
+    }
+
+    //Headless replays draw to memory like the benchmark
+    if (headless) {
+        SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+
+    bool replayMatched = true;
     if (!init()) {
         printf("Failed to initialize!\n");
     }
@@ -39,25 +106,61 @@ int main(int argc, char* args[]) {
             printf("Failed to load media!\n");
         }
         else {
+            //Decouple simulation from rendering
+            if (FIXED_TIMESTEP) {
+                gDeltaTime.setFixedTimestep(SIMULATION_TICK_RATE, MAX_SIMULATION_STEPS);
+            }
+
+            //Hold the frame rate
+            gFramePacer.setTargetFPS(SCREEN_FPS);
+            gFramePacer.setMode(gWindow.getRenderer(), PACE_CAPPED);
+
+            //Start capturing or feeding back input from tick zero
+            if (recordPath != nullptr && !gInputRecorder.startRecording(recordPath, SIMULATION_TICK_RATE)) {
+                quit = true;
+            }
+            if (replayPath != nullptr && !gInputRecorder.startReplay(replayPath, SIMULATION_TICK_RATE, gWindow.getWindowID())) {
+                quit = true;
+            }
+            if (headless && !quit) {
+                replayHeadless();
+            }
+
             fpsTimer.start();
             //While application is running
             while(!quit) {
-                //Start cap timer
-                capTimer.start();
+                //Start recording the frame
+                gProfiler.beginFrame();
 
-                //Handle events on queue
+                //Swap in edited assets before anything uses them this frame
+                gHotReloader.update();
+
+                //Handle events on queue, a replay drives the game so live input can only close the window
                 while(SDL_PollEvent(&e) != 0) {
+                    if (gInputRecorder.isReplaying() && e.type != SDL_QUIT && e.type != SDL_WINDOWEVENT) {
+                        continue;
+                    }
+                    //Debug keys stay out of recordings so replays do not toggle the profiler or pacing
+                    if ((e.type != SDL_KEYDOWN && e.type != SDL_KEYUP) || LDot::isControlKey(e.key.keysym.sym)) {
+                        gInputRecorder.record(e);
+                    }
                     eventHandler(quit, e);
                 }
 
                 //Render to screen
                 render();
+
+                //Close the recorded frame
+                gProfiler.endFrame();
             }
+
+            //End the recording, or check the replay ended the same way
+            replayMatched = gInputRecorder.stop(hashState());
         }
     }
 
     //Free resources and close SDL
     close();
 
-    return 0;
+    return replayMatched ? 0 : 1;
 }
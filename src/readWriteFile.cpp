@@ -186,7 +186,7 @@ bool loadMedia();
 void close();
 
 //Calculate distance between centres of two circles
-double distanceSquared(int x1, int y1, int x2, int y2);
+long long distanceSquared(int x1, int y1, int x2, int y2);
 
 //Circle-Circle collision detector
 bool checkCollision(const Circle& a, const Circle& b);
@@ -7,10 +7,36 @@
 #include <string>
 #include <sstream>
 
+void eventHandler(bool &quit, SDL_Event e);
+
+//Advances the simulation one fixed step, with the input a replay recorded for it
+void simulate() {
+    //Replayed input goes where live input would, a replay ends at its end record rather than a replayed escape
+    SDL_Event event;
+    bool replayQuit = false;
+    while (gInputRecorder.nextEvent(event)) {
+        eventHandler(replayQuit, event);
+    }
+    if (gInputRecorder.isFinished()) {
+        quit = true;
+        return;
+    }
+
+    //Move the dot and every entity, entities across every core
+    LJob* moved = gWorld.move(gJobSystem, gDeltaTime.getDeltaTime());
+    LJob* collided = gWorld.collide(gJobSystem, gTileMap, {moved});
+    LJob* contacts = gWorld.collideEntities(gJobSystem, {collided});
+    dot.move(gTileMap);
+
+    PROFILE_ZONE("simulation");
+    gJobSystem.wait(contacts);
+    gInputRecorder.endTick();
+}
+
 void render() {
     SDL_Renderer* gRenderer = gWindow.getRenderer();
     //Calculate and correct fps
-    float avgFPS = countedFrames / (fpsTimer.getTicks() / 1000.f);
+    float avgFPS = countedFrames / (static_cast<float>(fpsTimer.getTicks()) / NANOSECONDS_PER_SECOND);
     if (avgFPS > 2000000) {
         avgFPS = 0;
     }
@@ -18,38 +44,57 @@ void render() {
     //Set text to be rendered
     fpsText.str("");
     fpsText << static_cast<int>(avgFPS);
+    if (gFramePacer.getMissedDeadlines() > 0) {
+        fpsText << " (" << gFramePacer.getMissedDeadlines() << " missed)";
+    }
 
     //Update delta time
     gDeltaTime.update();
 
-    //Move the dot
-    dot.move(tiles);
-    dot.setCamera(gCamera);
+    //Step the simulation as many times as the elapsed time needs
+    while (gDeltaTime.tick() && !quit) {
+        simulate();
+    }
+    dot.setCamera(gCamera, gTileMap);
+
+    //Stream chunks around the camera and ahead of the dot
+    gChunkStreamer.update(gTileMap, gCamera, dot.getVelX(), dot.getVelY());
+
+    //Age the trails while the tiles are drawn
+    LJob* particles = gWorld.updateParticles(gJobSystem);
 
     //Clear screen
     gWindow.clear();
-
-    //Render text
-    if (!gFPSTextTexture.loadFromRenderedText(gRenderer, gFont, fpsText.str(), textColor)) {
-        printf("Unable to render text!\n");
-    }
+    gSpriteBatch.resetStatistics();
 
     //Render tiles
-    for (int i = 0; i < TOTAL_TILES; ++i) {
-        tiles[i]->render(gRenderer, gCamera);
+    {
+        PROFILE_ZONE("tiles");
+        if (gTileLayer.isBaked()) {
+            gTileLayer.render(gRenderer, gCamera);
+        }
+        else {
+            gTileMap.render(gRenderer, gCamera);
+        }
     }
 
     //Render textures
+    {
+        PROFILE_ZONE("particles wait");
+        gJobSystem.wait(particles);
+    }
+    gWorld.render(gRenderer, gCamera);
     dot.render(gRenderer, gCamera);
-    gFPSTextTexture.render(gRenderer, 0, 0);
+    gFontAtlas.renderText(gRenderer, fpsText.str(), 0, 0, textColor);
+
+    //Submit the batched sprites
+    gSpriteBatch.flush();
 
     //Update screen
     gWindow.render();
     ++countedFrames;
 
-    //If frame finished early
-    if (const int frameTicks = capTimer.getTicks(); frameTicks < SCREEN_TICKS_PER_FRAME) {
-        //Wait remaining time
-        SDL_Delay(SCREEN_TICKS_PER_FRAME - frameTicks);
-    }
+    //Wait for the next frame deadline
+    PROFILE_ZONE("pacing");
+    gFramePacer.waitForNextFrame();
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+//
+// Created by đỗ quyên on 17/10/26.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../headers/LMapFile.h"
+
+//Converts a whitespace separated text map into the binary map format
+int main(int argc, char* args[]) {
+    //Defaults match the lazy.map tile set
+    const char* inputPath = nullptr;
+    const char* outputPath = nullptr;
+    int columns = 0;
+    int tileWidth = 80, tileHeight = 80;
+    int chunkSize = 32;
+    bool compress = false;
+
+    //Read options
+    bool validArguments = true;
+    for (int i = 1; i < argc && validArguments; ++i) {
+        if (strcmp(args[i], "--columns") == 0 && i + 1 < argc) {
+            columns = atoi(args[++i]);
+        }
+        else if (strcmp(args[i], "--tile") == 0 && i + 2 < argc) {
+            tileWidth = atoi(args[++i]);
+            tileHeight = atoi(args[++i]);
+        }
+        else if (strcmp(args[i], "--chunk") == 0 && i + 1 < argc) {
+            chunkSize = atoi(args[++i]);
+        }
+        else if (strcmp(args[i], "--compress") == 0) {
+            compress = true;
+        }
+        else if (inputPath == nullptr) {
+            inputPath = args[i];
+        }
+        else if (outputPath == nullptr) {
+            outputPath = args[i];
+        }
+        else {
+            validArguments = false;
+        }
+    }
+    if (!validArguments || inputPath == nullptr || outputPath == nullptr || chunkSize <= 0 || chunkSize > MAP_MAX_CHUNK_SIZE || tileWidth <= 0 || tileHeight <= 0) {
+        printf("Usage: %s input.map output.lmap [--columns N] [--tile W H] [--chunk N] [--compress]\n", args[0]);
+        return 1;
+    }
+
+    //Open the text map
+    std::ifstream map(inputPath);
+    if (map.fail()) {
+        printf("Unable to open %s!\n", inputPath);
+        return 1;
+    }
+
+    //Row width is the first line's tile count unless given
+    std::string line;
+    std::getline(map, line);
+    if (columns <= 0) {
+        std::istringstream firstRow(line);
+        int tile;
+        while (firstRow >> tile) {
+            ++columns;
+        }
+    }
+
+    //Read every tile
+    std::vector<uint16_t> tiles;
+    std::istringstream firstRow(line);
+    int tile;
+    while (firstRow >> tile || (firstRow.eof() && map >> tile)) {
+        if (tile < 0 || tile > 0xFFFF) {
+            printf("Invalid tile %d at %zu!\n", tile, tiles.size());
+            return 1;
+        }
+        tiles.push_back(static_cast<uint16_t>(tile));
+    }
+
+    //Reading stops at anything that is not a number, only the end of the file is a clean stop
+    if (!firstRow.eof() || !map.eof()) {
+        printf("%s has something other than a tile id after tile %zu!\n", inputPath, tiles.size());
+        return 1;
+    }
+    if (columns <= 0 || tiles.empty() || tiles.size() % columns != 0) {
+        printf("%s does not hold whole rows of %d tiles!\n", inputPath, columns);
+        return 1;
+    }
+    const int rows = static_cast<int>(tiles.size() / columns);
+
+    //Write the binary map
+    if (!writeMapFile(outputPath, columns, rows, tileWidth, tileHeight, {tiles}, chunkSize, compress)) {
+        return 1;
+    }
+    printf("%s: %dx%d tiles of %dx%d in %d tile chunks\n", outputPath, columns, rows, tileWidth, tileHeight, chunkSize);
+
+    return 0;
+}